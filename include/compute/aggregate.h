@@ -0,0 +1,44 @@
+#pragma once
+
+#include <compute/filter.h>
+#include <core/batch.h>
+#include <core/bitmap.h>
+#include <core/column.h>
+#include <util/statistics.h>
+
+#include <cstddef>
+#include <optional>
+
+namespace Columnar::Compute {
+
+// Wide enough for the exact sum of any number of INT64 values that fits in
+// memory
+using Int128 = __int128;
+
+// SUM, MIN, MAX, COUNT and AVG of one column, computed in a single pass
+struct AggregateResult {
+    // aggregated rows, NULL rows are not counted
+    size_t count = 0;
+
+    // sum of the values of integer-based columns, the number of true values
+    // of BOOL columns, 0 for STRING columns
+    Int128 sum = 0;
+
+    // monostate if no row was aggregated
+    TStatistics::TMinMax min;
+    TStatistics::TMinMax max;
+
+    // sum / count, nullopt if no row was aggregated
+    std::optional<double> GetAverage() const;
+};
+
+// Aggregates the non-NULL rows of `column` that are set in `mask` (all rows
+// if null). Integer-based columns use SIMD reductions up to `isa`.
+AggregateResult Aggregate(const Column& column, const Bitmap* mask = nullptr);
+AggregateResult Aggregate(const Column& column, const Bitmap* mask,
+                          FilterIsa isa);
+
+// Aggregates the selected rows of one column of `batch`
+AggregateResult Aggregate(const Batch& batch, size_t columnIndex);
+
+}  // namespace Columnar::Compute
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <core/batch.h>
+#include <core/bitmap.h>
+#include <core/column.h>
+#include <util/statistics.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Columnar::Compute {
+
+using ECompareOp = TStatistics::ECompareOp;
+
+enum class FilterIsa : uint8_t {
+    SCALAR = 0,
+    AVX2 = 1,
+    AVX512 = 2
+};
+
+// Best implementation supported by the running CPU
+FilterIsa GetFilterIsa();
+
+// Bit i of the result is set if row i satisfies `column <op> constant`.
+// Integer-based columns (INT*, DATE, TIMESTAMP) take any integer constant,
+// BOOL columns a bool and STRING columns a string. NULL rows never match.
+// `isa` must not exceed GetFilterIsa().
+Bitmap CompareConstant(const Column& column, ECompareOp op,
+                       const TStatistics::TMinMax& constant);
+Bitmap CompareConstant(const Column& column, ECompareOp op,
+                       const TStatistics::TMinMax& constant, FilterIsa isa);
+
+// Row-wise `lhs <op> rhs` for columns of the same row count. Integer columns
+// of different widths are compared by value.
+Bitmap CompareColumns(const Column& lhs, ECompareOp op, const Column& rhs);
+Bitmap CompareColumns(const Column& lhs, ECompareOp op, const Column& rhs,
+                      FilterIsa isa);
+
+// Narrows the selection of `batch` (all rows if it has none) to the rows
+// where `column <op> constant` holds. Columns are not copied.
+void FilterBatch(Batch& batch, size_t columnIndex, ECompareOp op,
+                 const TStatistics::TMinMax& constant);
+
+}  // namespace Columnar::Compute
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <compute/aggregate.h>
+#include <core/batch.h>
+#include <core/dictionary_column.h>
+#include <core/german_string.h>
+#include <core/schema.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Columnar::Compute {
+
+enum class AggregateFunction : uint8_t {
+    COUNT = 0,
+    SUM = 1,
+    MIN = 2,
+    MAX = 3,
+    AVG = 4
+};
+
+struct AggregateSpec {
+    AggregateFunction function = AggregateFunction::COUNT;
+    // Input column, COUNT without a column counts rows. SUM, MIN, MAX and AVG
+    // take integer-based columns.
+    std::string column;
+    // Output column name, "sum(column)" style if empty
+    std::string name;
+};
+
+// Hash GROUP BY over a stream of batches. Key columns are hashed
+// column-at-a-time into per-row group ids, then every aggregate updates its
+// state array column-at-a-time. The linear-probing table only holds small
+// slots pointing to groups; keys and states live in dense per-group arrays.
+//
+// A single integer-based key is probed by value. Other keys are serialized
+// into byte strings kept as GermanStrings, so most mismatches are rejected
+// on the inlined prefix. NULL keys form a group of their own.
+class HashGroupBy {
+public:
+    HashGroupBy(const Schema& schema, std::vector<std::string> keys,
+                std::vector<AggregateSpec> aggregates);
+
+    HashGroupBy(const HashGroupBy&) = delete;
+    HashGroupBy& operator=(const HashGroupBy&) = delete;
+
+    // Adds the selected rows of `batch`, columns are found by name
+    void Consume(const Batch& batch);
+
+    // Same for a single STRING key given as dictionary codes, e.g. from
+    // FormatReader::ReadDictionaryColumn. Each distinct code is hashed once,
+    // rows map to groups by array lookup. The key column may be missing
+    // from `batch`.
+    void Consume(const Batch& batch, const DictionaryColumn& keys);
+
+    size_t GetGroupCount() const;
+
+    // Key columns followed by one column per aggregate, groups in the order
+    // they were first seen. COUNT and SUM are INT64, MIN and MAX keep the
+    // input type. The engine has no floating point type, AVG is its decimal
+    // text. Aggregates over no values are NULL, except COUNT. Throws
+    // std::overflow_error if a sum does not fit INT64.
+    Batch GetResult() const;
+
+private:
+    static constexpr uint32_t kEmptyGroup = UINT32_MAX;
+    static constexpr size_t kInitialSlotCount = 1024;
+
+    struct Slot {
+        uint32_t tag;  // upper hash bits, most mismatches stop here
+        uint32_t group;
+    };
+
+    struct IntegerSlot {
+        int64_t key;
+        uint32_t group;
+    };
+
+    // State arrays indexed by group id, only the ones `function` needs
+    struct AggregateState {
+        AggregateSpec spec;
+        Types::DataType inputType = Types::DataType::INT64;
+        std::vector<int64_t> counts;  // non-NULL inputs
+        std::vector<Int128> sums;
+        std::vector<int64_t> values;  // MIN or MAX so far
+    };
+
+    std::vector<ColumnSchema> keys_;
+    std::vector<AggregateState> aggregates_;
+    bool integerKey_ = false;
+    size_t groupCount_ = 0;
+
+    // single integer key
+    std::vector<IntegerSlot> integerSlots_;
+    std::vector<int64_t> integerKeys_;
+    std::optional<uint32_t> nullGroup_;
+
+    // any other keys
+    std::vector<Slot> slots_;
+    GermanStringVector serializedKeys_;
+    std::vector<uint64_t> hashes_;
+
+    // reused between batches
+    std::vector<uint32_t> groups_;
+    std::vector<size_t> offsets_;
+    std::vector<char> buffer_;
+
+    uint32_t FindIntegerGroup(int64_t key);
+    uint32_t FindSerializedGroup(std::string_view key, uint64_t hash);
+    uint32_t AddGroup();
+    void Grow();
+
+    void MapIntegerKeys(const Batch& batch,
+                        const std::vector<uint32_t>* rows);
+    void MapSerializedKeys(const Batch& batch,
+                           const std::vector<uint32_t>* rows);
+    void UpdateAggregates(const Batch& batch,
+                          const std::vector<uint32_t>* rows);
+
+    std::vector<Column> DecodeKeys() const;
+};
+
+}  // namespace Columnar::Compute
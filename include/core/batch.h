@@ -1,13 +1,20 @@
 #pragma once
 
+#include <core/bitmap.h>
 #include <core/column.h>
 #include <core/schema.h>
+#include <cstdint>
+#include <optional>
 #include <vector>
 
 namespace Columnar {
 
 constexpr size_t kBatchSize = 2048;
 
+// Below this fraction of selected rows CompactIfSparse copies the selected
+// rows out, above it consumers read through the selection
+constexpr double kCompactSelectivity = 0.25;
+
 class Batch {
 public:
     // ctors
@@ -29,6 +36,7 @@ public:
     // Get meta
 
     size_t GetColumnCount() const;
+    // Physical rows in the columns, selected or not
     size_t GetRowCount() const;
     bool IsEmpty() const;
     bool IsFull() const;
@@ -56,6 +64,26 @@ public:
 
     const_iterator end() const { return columns_.end(); }
 
+    // Selection: ascending indices of the rows that are part of the batch.
+    // Columns keep every row until Compact(); the CSV and .iyx writers
+    // output only the selected rows.
+    bool HasSelection() const;
+    const std::vector<uint32_t>* GetSelection() const;  // nullptr if none
+    size_t GetSelectedRowCount() const;
+    // Bit set for every selected row, all bits set if there is no selection
+    Bitmap GetSelectionMask() const;
+
+    void SetSelection(std::vector<uint32_t> rows);
+    void SetSelectionMask(const Bitmap& mask);
+    void ClearSelection();
+
+    // Copies the selected rows into every column and drops the selection
+    void Compact();
+    // Compacts only if fewer than `selectivity` of the rows are selected
+    void CompactIfSparse(double selectivity = kCompactSelectivity);
+    // New batch with only the selected rows, this batch is left as is
+    Batch GetCompacted() const;
+
     // modification
 
     bool AppendRow(std::vector<std::string>&& values);
@@ -71,6 +99,7 @@ private:
     Schema schema_;
     std::vector<Column> columns_;
     size_t rowCount_ = 0;
+    std::optional<std::vector<uint32_t>> selection_;
 
     void ValidateColumns() const;
     void UpdateRowCount();
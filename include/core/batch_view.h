@@ -0,0 +1,37 @@
+#pragma once
+
+#include <core/batch.h>
+#include <core/column_view.h>
+#include <core/schema.h>
+
+#include <vector>
+
+namespace Columnar {
+
+// Read-only counterpart of Batch built from ColumnViews
+class BatchView {
+public:
+    // ctors
+    BatchView() = default;
+
+    BatchView(Schema schema, std::vector<ColumnView> columns);
+
+    // Get meta
+    size_t GetColumnCount() const;
+    size_t GetRowCount() const;
+    const Schema& GetSchema() const;
+
+    // Columns access
+    const ColumnView& GetColumn(size_t index) const;
+    const ColumnView* FindColumn(const std::string& name) const;
+
+    // Copies all columns into an owning Batch
+    Batch Materialize() const;
+
+private:
+    Schema schema_;
+    std::vector<ColumnView> columns_;
+    size_t rowCount_ = 0;
+};
+
+}  // namespace Columnar
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+namespace Columnar {
+
+// Bit-packed storage of a BOOL column: bit i of words[i / 64] holds row i.
+// Bits past size() are kept zero, so words can be compared, counted and
+// combined directly. Same layout is used on disk.
+class Bitmap {
+public:
+    static constexpr size_t kWordBits = 64;
+
+    // ctors
+    Bitmap() = default;
+
+    explicit Bitmap(size_t size, bool value = false);
+
+    Bitmap(std::initializer_list<bool> values);
+
+    explicit Bitmap(const std::vector<bool>& values);
+
+    // Takes prepared words, bits past size are cleared
+    Bitmap(std::vector<uint64_t> words, size_t size);
+
+    static size_t GetWordCount(size_t size) {
+        return (size + kWordBits - 1) / kWordBits;
+    }
+
+    // Get meta
+    size_t size() const { return size_; }
+
+    bool empty() const { return size_ == 0; }
+
+    // Number of set bits
+    size_t CountSet() const;
+
+    // Indices of set bits in ascending order
+    std::vector<uint32_t> GetSetIndices() const;
+
+    // Data access
+    bool operator[](size_t index) const {
+        return (words_[index / kWordBits] >> (index % kWordBits)) & 1;
+    }
+
+    std::span<const uint64_t> GetWords() const { return words_; }
+
+    // Modification
+    void Set(size_t index, bool value) {
+        uint64_t mask = uint64_t{1} << (index % kWordBits);
+        if (value) {
+            words_[index / kWordBits] |= mask;
+        } else {
+            words_[index / kWordBits] &= ~mask;
+        }
+    }
+
+    void push_back(bool value) {
+        if (size_ % kWordBits == 0) {
+            words_.push_back(0);
+        }
+        words_.back() |= uint64_t{value} << (size_ % kWordBits);
+        ++size_;
+    }
+
+    void resize(size_t size, bool value = false);
+
+    void reserve(size_t capacity);
+
+    void clear();
+
+    // Word-wise combination with a bitmap of the same size
+    Bitmap& operator&=(const Bitmap& other);
+    Bitmap& operator|=(const Bitmap& other);
+
+    bool operator==(const Bitmap& other) const = default;
+
+private:
+    void CheckSameSize(const Bitmap& other) const;
+    void ClearTail();
+
+    std::vector<uint64_t> words_;
+    size_t size_ = 0;
+};
+
+}  // namespace Columnar
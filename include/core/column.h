@@ -1,6 +1,10 @@
 #pragma once
 
+#include <core/bitmap.h>
 #include <core/types.h>
+#include <cstdint>
+#include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -22,9 +26,12 @@ public:
                               std::vector<int32_t> data);
     static Column CreateInt64(const std::string& name,
                               std::vector<int64_t> data);
-    static Column CreateBool(const std::string& name, std::vector<bool> data);
+    static Column CreateBool(const std::string& name,
+                             const std::vector<bool>& data);
+    static Column CreateBool(const std::string& name, Bitmap data);
     static Column CreateString(const std::string& name,
                                std::vector<std::string> data);
+    static Column CreateString(const std::string& name, StringVector data);
 
     // Get meta
     const std::string& GetName() const;
@@ -36,22 +43,43 @@ public:
     const Types::AnyColumnData& GetData() const;
     Types::AnyColumnData& GetMutableData();
 
+    // NULL rows print as empty strings
     std::string GetValueAsString(size_t row) const;
 
+    // Validity: nullptr if every row is valid, otherwise bit i is set for
+    // non-NULL rows. NULL rows hold a default value in the data.
+    const Bitmap* GetValidity() const;
+    bool IsNull(size_t row) const;
+    size_t GetNullCount() const;
+
     template <typename T>
-    const std::vector<T>& GetTypedData() const {
-        return std::get<std::vector<T>>(data_);
+    const Types::ColumnVector<T>& GetTypedData() const {
+        return std::get<Types::ColumnVector<T>>(data_);
     }
 
     template <typename T>
-    std::vector<T>& GetMutuableTypedData() {
-        return std::get<std::vector<T>>(data_);
+    Types::ColumnVector<T>& GetMutuableTypedData() {
+        return std::get<Types::ColumnVector<T>>(data_);
     }
 
+    // Copy of the listed rows, validity included
+    Column Select(std::span<const uint32_t> rows) const;
+
     // Modification
 
+    // An empty value is NULL for every type except STRING
     void AppendFromString(std::string&& value);
 
+    void AppendNull();
+    void SetNull(size_t row);
+
+    // An all-set bitmap is dropped, so dense columns stay on the fast path
+    void SetValidity(std::optional<Bitmap> validity);
+
+    // Validity sized to the row count, created all-valid if absent. Code
+    // that appends to the typed data directly calls it to extend validity.
+    Bitmap& GetMutableValidity();
+
     void Reserve(size_t capacity);
 
     void Clear();
@@ -60,6 +88,7 @@ private:
     std::string name_;
     Types::DataType type_;  // Maybe set default to str
     Types::AnyColumnData data_;
+    std::optional<Bitmap> validity_;
 };
 
 }  // namespace Columnar
\ No newline at end of file
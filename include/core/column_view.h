@@ -0,0 +1,79 @@
+#pragma once
+
+#include <core/column.h>
+#include <core/types.h>
+
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace Columnar {
+
+// Read-only column that either points into external memory (for example a
+// mapped file) or wraps a materialized Column. `owner` keeps the external
+// memory alive for as long as any view refers to it.
+class ColumnView {
+public:
+    // ctors
+    ColumnView() = default;
+
+    ColumnView(std::string name, Types::DataType type, const void* data,
+               size_t rowCount, std::shared_ptr<const void> owner);
+
+    explicit ColumnView(Column column);
+
+    // Get meta
+    const std::string& GetName() const;
+    Types::DataType GetType() const;
+    size_t GetRowCount() const;
+
+    // true if data lives in external memory and no copy was made
+    bool IsZeroCopy() const;
+
+    // Data access
+
+    // Works for INT16/INT32/INT64 based types, both for external memory and
+    // materialized columns
+    template <typename T>
+    std::span<const T> GetTypedData() const {
+        static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                      "Typed views are supported for integer types only");
+
+        if (!Types::IsFixedSize(type_) || type_ == Types::DataType::BOOL ||
+            Types::GetTypeSize(type_) != sizeof(T)) {
+            throw std::logic_error("Column " + name_ + " is not viewable as " +
+                                   std::to_string(sizeof(T) * 8) +
+                                   "-bit integers");
+        }
+
+        if (column_) {
+            return column_->GetTypedData<T>();
+        }
+
+        return {static_cast<const T*>(data_), rowCount_};
+    }
+
+    // Zero-copy views never have NULLs
+    const Bitmap* GetValidity() const {
+        return column_ ? column_->GetValidity() : nullptr;
+    }
+
+    // Materialized column, only for views that are not zero-copy
+    const Column& GetColumn() const;
+
+    // Copies data into an owning Column
+    Column Materialize() const;
+
+private:
+    std::string name_;
+    Types::DataType type_ = Types::DataType::INT64;
+    size_t rowCount_ = 0;
+
+    const void* data_ = nullptr;
+    std::shared_ptr<const void> owner_;
+    std::shared_ptr<const Column> column_;
+};
+
+}  // namespace Columnar
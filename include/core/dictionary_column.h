@@ -0,0 +1,28 @@
+#pragma once
+
+#include <core/column.h>
+#include <core/string_vector.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Columnar {
+
+// Dictionary-encoded string column: row i holds dictionary[codes[i]].
+// Consumers that group or compare by value can work on the codes directly.
+// NULL rows have a cleared bit in `validity`, their codes are arbitrary.
+struct DictionaryColumn {
+    std::string name;
+    StringVector dictionary;
+    std::vector<uint32_t> codes;
+    std::optional<Bitmap> validity;
+
+    size_t GetRowCount() const;
+
+    // Expands codes into a regular STRING column
+    Column Materialize() const;
+};
+
+}  // namespace Columnar
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <core/string_vector.h>
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace Columnar {
+
+// 16-byte string entry: length, the first 4 bytes, then either the next 8
+// bytes (strings up to 12 bytes are stored inline) or a pointer to the full
+// string. Unused inline bytes are zero, so equality and ordering usually
+// resolve on the first 8 bytes without touching the string data.
+class GermanString {
+public:
+    static constexpr size_t kPrefixLength = 4;
+    static constexpr size_t kInlineLength = 12;
+
+    GermanString() = default;
+
+    // `data` must outlive the entry if the value is not inlined
+    static GermanString Make(std::string_view value, const char* data);
+
+    size_t size() const { return length_; }
+
+    bool empty() const { return length_ == 0; }
+
+    bool IsInline() const { return length_ <= kInlineLength; }
+
+    std::string_view GetPrefix() const {
+        return {prefix_, length_ < kPrefixLength ? length_ : kPrefixLength};
+    }
+
+    std::string_view view() const {
+        // prefix_ and inline_ are adjacent and hold the inlined value
+        const char* inlined = reinterpret_cast<const char*>(this) +
+                              offsetof(GermanString, prefix_);
+        return {IsInline() ? inlined : pointer_, length_};
+    }
+
+    bool StartsWith(std::string_view prefix) const;
+
+    friend bool operator==(const GermanString& lhs, const GermanString& rhs);
+
+    friend std::strong_ordering operator<=>(const GermanString& lhs,
+                                            const GermanString& rhs);
+
+private:
+    uint32_t length_ = 0;
+    char prefix_[kPrefixLength] = {};
+    union {
+        char inline_[kInlineLength - kPrefixLength] = {};
+        const char* pointer_;
+    };
+
+    uint64_t GetHead() const;
+};
+
+static_assert(sizeof(GermanString) == 16);
+
+// GermanString entries over a chunked arena owned by the vector. Arena blocks
+// never move, so entries stay valid when the vector grows or is moved.
+class GermanStringVector {
+public:
+    static constexpr size_t kArenaBlockSize = 64 << 10;
+
+    using const_iterator = std::vector<GermanString>::const_iterator;
+
+    // ctors
+    GermanStringVector() = default;
+
+    explicit GermanStringVector(const StringVector& values);
+
+    GermanStringVector(const GermanStringVector& other);
+    GermanStringVector& operator=(const GermanStringVector& other);
+
+    // The moved-from vector is left empty with no open arena block
+    GermanStringVector(GermanStringVector&& other) noexcept;
+    GermanStringVector& operator=(GermanStringVector&& other) noexcept;
+
+    // Get meta
+    size_t size() const { return entries_.size(); }
+
+    bool empty() const { return entries_.empty(); }
+
+    // Bytes held by the arena, inlined strings take none
+    size_t GetArenaSize() const { return arenaSize_; }
+
+    // Data access
+    const GermanString& operator[](size_t index) const {
+        return entries_[index];
+    }
+
+    const_iterator begin() const { return entries_.begin(); }
+
+    const_iterator end() const { return entries_.end(); }
+
+    // Modification
+    void push_back(std::string_view value);
+
+    void reserve(size_t capacity);
+
+    void clear();
+
+private:
+    std::vector<GermanString> entries_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* blockPos_ = nullptr;
+    size_t blockLeft_ = 0;
+    size_t arenaSize_ = 0;
+
+    const char* Store(std::string_view value);
+};
+
+}  // namespace Columnar
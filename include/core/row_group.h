@@ -1,17 +1,27 @@
 #pragma once
 
 #include <core/batch.h>
+#include <util/statistics.h>
 
 #include <cstdint>
+#include <vector>
 
 namespace Columnar {
 
+struct ColumnChunkMeta {
+    uint64_t offset = 0;  // offset in file (bytes)
+    uint64_t size = 0;    // chunk size (bytes)
+    Types::Encoding encoding = Types::Encoding::PLAIN;
+
+    TStatistics statistics;  // zone map: min/max and null count
+};
+
 struct RowGroupMeta {
     uint64_t offset = 0;  // offset in file (bytes)
     uint64_t size = 0;    // data size (bytes)
     uint32_t rowCount = 0;
 
-    static constexpr size_t kSerializedSize = 20;
+    std::vector<ColumnChunkMeta> columns;  // in schema order
 };
 
 class RowGroup {
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Columnar {
+
+// Storage of a STRING column: one contiguous character blob plus an offsets
+// array with size() + 1 entries, row i is chars[offsets[i], offsets[i + 1]).
+// Same layout is used for plain string chunks on disk, so a chunk is loaded
+// with two copies and no per-row allocations.
+class StringVector {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::string_view;
+
+        const_iterator() = default;
+
+        const_iterator(const StringVector* owner, size_t index)
+            : owner_(owner),
+              index_(index) {}
+
+        std::string_view operator*() const { return (*owner_)[index_]; }
+
+        std::string_view operator[](difference_type n) const {
+            return (*owner_)[index_ + n];
+        }
+
+        const_iterator& operator++() {
+            ++index_;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            auto copy = *this;
+            ++index_;
+            return copy;
+        }
+
+        const_iterator& operator--() {
+            --index_;
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            auto copy = *this;
+            --index_;
+            return copy;
+        }
+
+        const_iterator& operator+=(difference_type n) {
+            index_ += n;
+            return *this;
+        }
+
+        const_iterator& operator-=(difference_type n) {
+            index_ -= n;
+            return *this;
+        }
+
+        friend const_iterator operator+(const_iterator it, difference_type n) {
+            return it += n;
+        }
+
+        friend const_iterator operator+(difference_type n, const_iterator it) {
+            return it += n;
+        }
+
+        friend const_iterator operator-(const_iterator it, difference_type n) {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const const_iterator& lhs,
+                                         const const_iterator& rhs) {
+            return static_cast<difference_type>(lhs.index_) -
+                   static_cast<difference_type>(rhs.index_);
+        }
+
+        friend auto operator<=>(const const_iterator& lhs,
+                                const const_iterator& rhs) {
+            return lhs.index_ <=> rhs.index_;
+        }
+
+        friend bool operator==(const const_iterator& lhs,
+                               const const_iterator& rhs) {
+            return lhs.index_ == rhs.index_;
+        }
+
+    private:
+        const StringVector* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using value_type = std::string_view;
+    using iterator = const_iterator;
+
+    // ctors
+    StringVector();
+
+    StringVector(std::initializer_list<std::string_view> values);
+
+    explicit StringVector(const std::vector<std::string>& values);
+
+    // Takes prepared buffers, offsets must start with 0 and be non-decreasing
+    StringVector(std::vector<uint32_t> offsets, std::vector<char> chars);
+
+    StringVector(const StringVector&) = default;
+    StringVector& operator=(const StringVector&) = default;
+
+    // The moved-from vector is left empty and usable
+    StringVector(StringVector&& other) noexcept;
+    StringVector& operator=(StringVector&& other) noexcept;
+
+    // Get meta
+    size_t size() const { return offsets_.size() - 1; }
+
+    bool empty() const { return size() == 0; }
+
+    // Data access
+    std::string_view operator[](size_t index) const {
+        return {chars_.data() + offsets_[index],
+                offsets_[index + 1] - offsets_[index]};
+    }
+
+    std::string_view at(size_t index) const;
+
+    std::span<const uint32_t> GetOffsets() const;
+    std::span<const char> GetChars() const;
+
+    const_iterator begin() const { return {this, 0}; }
+
+    const_iterator end() const { return {this, size()}; }
+
+    // Modification
+    void push_back(std::string_view value);
+
+    void reserve(size_t capacity);
+    void reserve(size_t capacity, size_t charsCapacity);
+
+    void clear();
+
+    bool operator==(const StringVector& other) const;
+
+private:
+    std::vector<uint32_t> offsets_;
+    std::vector<char> chars_;
+};
+
+}  // namespace Columnar
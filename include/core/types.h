@@ -2,9 +2,13 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
 #include <variant>
+#include <type_traits>
 #include <vector>
 
+#include <core/bitmap.h>
+#include <core/string_vector.h>
 #include <util/types_macro.h>
 
 namespace Columnar::Types {
@@ -18,16 +22,23 @@ enum class DataType : uint8_t {
     INT128 = 3,  // TODO: add int128 support
     BOOL = 4,
     STRING = 5,
-    DATE = 6,      // TODO: add date support
-    TIMESTAMP = 7  // TODO: add timestamp support
+    DATE = 6,
+    TIMESTAMP = 7
 };
 
 using AnyColumnType =
     std::variant<int16_t, int32_t, int64_t, bool, std::string>;
 
-using AnyColumnData = std::variant<std::vector<int16_t>, std::vector<int32_t>,
-                                   std::vector<int64_t>, std::vector<bool>,
-                                   std::vector<std::string>>;
+// In-memory storage of a column with values of type T
+template <typename T>
+using ColumnVector = std::conditional_t<
+    std::is_same_v<T, std::string>, StringVector,
+    std::conditional_t<std::is_same_v<T, bool>, Bitmap, std::vector<T>>>;
+
+using AnyColumnData =
+    std::variant<ColumnVector<int16_t>, ColumnVector<int32_t>,
+                 ColumnVector<int64_t>, ColumnVector<bool>,
+                 ColumnVector<std::string>>;
 
 template <typename... Ts>
 struct overloaded : Ts... {
@@ -40,6 +51,15 @@ constexpr size_t kFileHeaderSize = 64;
 constexpr size_t kRowGroupHeaderSize = 32;
 constexpr size_t kChunkHeaderSize = 24;
 
+// Column chunk encodings, stored per chunk in the footer
+enum class Encoding : uint8_t {
+    PLAIN = 0,
+    BIT_PACKED = 1,  // frame of reference: offsets from chunk min, bit-packed
+    DELTA = 2,       // first value + bit-packed (delta - min delta)
+    RLE = 3,         // run values + run lengths
+    DICTIONARY = 4   // distinct strings + bit-packed codes
+};
+
 // Helper functions
 
 size_t GetTypeSize(DataType type);
@@ -7,9 +7,12 @@
 
 namespace Columnar::IO {
 
-constexpr uint8_t kMagicBytes[4] = {'I', 'Y', 'X', 0x01};
+constexpr uint8_t kFormatVersion = 0x09;
+constexpr uint8_t kMagicBytes[4] = {'I', 'Y', 'X', kFormatVersion};
 constexpr size_t kMagicSize = 4;
 constexpr size_t kHeaderSize = 64;
+constexpr size_t kChunkAlignment = 8;  // row groups and column chunks
+constexpr size_t kWriteBufferSize = 1 << 20;  // 1 MiB
 
 class BinaryWriter {
 public:
@@ -21,9 +24,14 @@ public:
     BinaryWriter(BinaryWriter&&) = default;
     BinaryWriter& operator=(BinaryWriter&&) = default;
 
+    // Small writes are accumulated in a user-space buffer, writes larger than
+    // the buffer go straight to the file
     void Write(const void* data, size_t size);
     void WriteString(const std::string& str);  // length-prefixed (uint32)
 
+    // Writes zero bytes until position is a multiple of `alignment`
+    void WritePadding(size_t alignment);
+
     size_t GetPosition();
     void Seek(size_t position);
     void Flush();
@@ -32,8 +40,15 @@ public:
 
 private:
     std::ofstream file_;
+    std::vector<char> buffer_;
+    size_t buffered_ = 0;
+
+    void FlushBuffer();
 };
 
+// Reads through a file descriptor. Sequential Read/Seek keep a cursor and
+// are meant for parsing metadata; ReadAt is a positional read (pread) that
+// does not touch the cursor and may be called from many threads at once.
 class BinaryReader {
 public:
     explicit BinaryReader(const std::string& filename);
@@ -41,21 +56,49 @@ public:
     BinaryReader(const BinaryReader&) = delete;
     BinaryReader& operator=(const BinaryReader&) = delete;
 
-    BinaryReader(BinaryReader&&) = default;
-    BinaryReader& operator=(BinaryReader&&) = default;
+    BinaryReader(BinaryReader&& other) noexcept;
+    BinaryReader& operator=(BinaryReader&& other) noexcept;
 
     void Read(void* buffer, size_t size);
     std::string ReadString();  // length-prefixed (uint32)
 
-    size_t GetPosition();
+    void ReadAt(uint64_t offset, void* buffer, size_t size) const;
+
+    size_t GetPosition() const;
     void Seek(size_t position);
     size_t GetFileSize() const;
 
     ~BinaryReader();
 
 private:
-    std::ifstream file_;
+    int fd_ = -1;
+    size_t position_ = 0;
     size_t fileSize_ = 0;
 };
 
+// Reads values from an in-memory block with the same layout BinaryReader
+// expects on disk. Does not own the data.
+class BufferReader {
+public:
+    BufferReader(const char* data, size_t size);
+
+    void Read(void* buffer, size_t size);
+    std::string ReadString();  // length-prefixed (uint32)
+
+    // Returns pointer to the next `size` bytes and skips them
+    const char* ReadBytes(size_t size);
+
+    // Skips bytes until position is a multiple of `alignment`
+    void SkipPadding(size_t alignment);
+
+    size_t GetPosition() const;
+    void Seek(size_t position);
+    size_t GetSize() const;
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    size_t position_ = 0;
+};
+
 }  // namespace Columnar::IO
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <io/format_reader.h>
+#include <parser/csv_parser.h>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Columnar::IO {
+
+struct CsvExportOptions {
+    // 0 means std::thread::hardware_concurrency()
+    size_t threads = 0;
+    // row groups decoded or formatted but not yet written, 0 means
+    // 2 * threads
+    size_t maxInFlight = 0;
+    Parser::CsvParserOptions csv;
+    // called after a row group has been written, in row-group order
+    std::function<void(size_t rowGroup, size_t rowCount)> onRowGroupWritten;
+};
+
+// Decodes and formats the row groups of an opened reader on a thread pool
+// and writes the text in row-group order. File k of `filenames` receives
+// the contiguous row groups [k * count / files, (k + 1) * count / files),
+// so run lengths differ by at most one and a file is left empty if there
+// are more files than row groups. Returns the number of rows written.
+size_t ExportCsv(const FormatReader& reader,
+                 const std::vector<std::string>& filenames,
+                 const CsvExportOptions& options = {});
+
+}  // namespace Columnar::IO
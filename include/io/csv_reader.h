@@ -2,10 +2,14 @@
 
 #include <core/batch.h>
 #include <core/schema.h>
+#include <parser/csv_parser.h>
+#include <parser/csv_tokenizer.h>
 
+#include <cstdint>
 #include <fstream>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace Columnar::IO {
 
@@ -24,11 +28,21 @@ public:
 private:
     std::ifstream file_;
     Schema schema_;
+    Parser::CsvParserOptions options_;
     size_t totalRowsRead_ = 0;
     size_t lineNumber_ = 0;
 
-    std::optional<std::string> ReadLine();
-    void ParseAndAppendRow(std::string&& line, Batch& batch);
+    // reused between batches: lines of the current batch with their offsets
+    // and line numbers, tokens and the first field of every record
+    std::string block_;
+    std::string line_;
+    std::vector<size_t> lineStarts_;
+    std::vector<size_t> lineNumbers_;
+    Parser::CsvTokens tokens_;
+    std::vector<uint32_t> records_;
+
+    bool ReadLine();
+    size_t GetLineNumber(size_t offset) const;
 };
 
 }  // namespace Columnar::IO
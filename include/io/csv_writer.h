@@ -1,17 +1,50 @@
 #pragma once
 
 #include <core/batch.h>
+#include <core/string_vector.h>
+#include <parser/csv_parser.h>
 
 #include <fstream>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace Columnar::IO {
 
+struct CsvWriterOptions {
+    // output is collected in a buffer of this size and written in one call
+    size_t bufferSize = 4 << 20;
+    Parser::CsvParserOptions csv;
+};
+
+// Formats a batch column-at-a-time into per-column text buffers, then
+// interleaves them row by row into the output. String columns are copied
+// only if one of their values has to be quoted.
+class CsvFormatter {
+public:
+    explicit CsvFormatter(Parser::CsvParserOptions options = {});
+
+    // Appends the selected rows of `batch` as CSV text to `out`
+    void Format(const Batch& batch, std::vector<char>& out);
+
+private:
+    Parser::CsvParserOptions options_;
+
+    // reused between batches: formatted text of every column
+    std::vector<StringVector> formatted_;
+};
+
 class CsvWriter {
 public:
-    explicit CsvWriter(const std::string& filename);
+    explicit CsvWriter(const std::string& filename,
+                       CsvWriterOptions options = {});
+
+    CsvWriter(const CsvWriter&) = delete;
+    CsvWriter& operator=(const CsvWriter&) = delete;
 
     void WriteBatch(const Batch& batch);
+    // Writes `rowCount` rows already formatted by a CsvFormatter
+    void WriteFormatted(std::span<const char> text, size_t rowCount);
     void Flush();
 
     size_t GetRowsWritten() const;
@@ -20,7 +53,13 @@ public:
 
 private:
     std::ofstream file_;
+    CsvWriterOptions options_;
+    CsvFormatter formatter_;
     size_t rowsWritten_ = 0;
+
+    std::vector<char> buffer_;
+
+    void WriteBuffer();
 };
 
 }  // namespace Columnar::IO
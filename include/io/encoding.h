@@ -0,0 +1,57 @@
+#pragma once
+
+#include <core/dictionary_column.h>
+#include <core/types.h>
+#include <io/binary_io.h>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Columnar::IO {
+
+// Bit packing works on blocks of 64 values: a block of width W takes exactly
+// W 64-bit words, so unpacking a block needs no per-value branches
+constexpr size_t kBitPackBlockSize = 64;
+
+size_t GetBitWidth(uint64_t maxValue);
+
+// Bytes taken by `count` values packed with `bitWidth` (whole blocks)
+size_t GetBitPackedSize(size_t count, size_t bitWidth);
+
+void BitPack(const uint64_t* values, size_t count, size_t bitWidth, char* out);
+
+// out[i] = base + packed[i] (mod 2^64), truncated to T
+template <typename T>
+void BitUnpack(const char* in, size_t count, size_t bitWidth, uint64_t base,
+               T* out);
+
+// Chooses the smallest of PLAIN, BIT_PACKED, DELTA and RLE for an integer
+// chunk. Non-plain encodings are appended to `out`; for PLAIN nothing is
+// written and the caller is expected to store the values as is.
+template <typename T>
+Types::Encoding EncodeIntegers(std::span<const T> values,
+                               std::vector<char>& out);
+
+template <typename T>
+void DecodeIntegers(Types::Encoding encoding, BufferReader& input,
+                    std::span<T> out);
+
+// Chunks with at most this many distinct values may be dictionary encoded
+constexpr size_t kMaxDictionarySize = 1 << 16;
+
+// Dictionary encodes a string chunk if that is smaller than the plain layout.
+// Returns PLAIN without writing anything otherwise.
+Types::Encoding EncodeStrings(const StringVector& values,
+                              std::vector<char>& out);
+
+// Plain BOOL layout: ceil(rowCount / 64) little-endian u64 words
+Bitmap DecodeBitmap(BufferReader& input, size_t rowCount);
+
+// Plain string layout: u32 offsets[rowCount + 1] followed by the characters
+StringVector DecodePlainStrings(BufferReader& input, size_t rowCount);
+
+DictionaryColumn DecodeDictionary(BufferReader& input, size_t rowCount);
+
+}  // namespace Columnar::IO
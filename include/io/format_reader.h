@@ -1,18 +1,39 @@
 #pragma once
 
+#include <core/batch_view.h>
+#include <core/dictionary_column.h>
 #include <core/row_group.h>
 #include <core/schema.h>
 #include <io/binary_io.h>
+#include <io/mapped_file.h>
+#include <io/uring_reader.h>
+#include <util/statistics.h>
 
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace Columnar::IO {
 
+struct FormatReaderOptions {
+    // map the file into memory instead of reading row groups through ifstream
+    bool useMmap = false;
+    // fetch chunks through io_uring (Linux), falls back to stream reads if
+    // the kernel refuses to set up a ring. Ignored in mmap mode.
+    bool useIoUring = false;
+    unsigned ioQueueDepth = UringReader::kDefaultQueueDepth;
+};
+
+// After Open() the metadata is immutable and the const read methods use
+// positional reads only, so several threads may read row groups of one
+// opened reader concurrently. ReadBatch/HasMore keep a cursor and are not
+// thread-safe.
 class FormatReader {
 public:
-    explicit FormatReader(const std::string& filename);
+    explicit FormatReader(const std::string& filename,
+                          FormatReaderOptions options = {});
     ~FormatReader() = default;
 
     FormatReader(const FormatReader&) = delete;
@@ -25,18 +46,60 @@ public:
 
     std::optional<Batch> ReadBatch();
     bool HasMore() const;
-    RowGroup ReadRowGroup(size_t index);
+    RowGroup ReadRowGroup(size_t index) const;
+
+    // Projections: only the chunks of the listed columns (schema indices) are
+    // read. Result batch columns follow the order of `columnIndices`.
+    std::optional<Batch> ReadBatch(const std::vector<size_t>& projection);
+    RowGroup ReadRowGroup(size_t index,
+                          const std::vector<size_t>& columnIndices) const;
+
+    // Reads several row groups with all chunk reads issued together, which
+    // lets the io_uring backend keep a deep queue
+    std::vector<RowGroup> ReadRowGroups(
+        const std::vector<size_t>& indices,
+        const std::vector<size_t>& columnIndices) const;
+
+    // Fixed-width integer columns point straight into the mapped file in mmap
+    // mode (or into a shared read buffer otherwise), other columns are decoded
+    BatchView ReadRowGroupView(size_t index) const;
+    BatchView ReadRowGroupView(size_t index,
+                               const std::vector<size_t>& columnIndices) const;
+
+    // Codes and dictionary of a dictionary-encoded string chunk without
+    // expanding them to strings. nullopt if the chunk uses another encoding.
+    std::optional<DictionaryColumn> ReadDictionaryColumn(
+        size_t index, size_t columnIndex) const;
 
     const Schema& GetSchema() const;
+    bool UsesIoUring() const;
     size_t GetRowGroupCount() const;
     const RowGroupMeta& GetRowGroupMeta(size_t index) const;
     uint64_t GetTotalRowCount() const;
 
+    // Maps column names to schema indices, throws on unknown names
+    std::vector<size_t> GetColumnIndices(
+        const std::vector<std::string>& names) const;
+
+    // Predicate pushdown: ReadBatch skips row groups whose zone maps prove
+    // that no row satisfies all predicates. Rows inside returned batches are
+    // not filtered.
+    void SetPredicates(std::vector<TPredicate> predicates);
+    // `literal` is parsed according to the column type (e.g. timestamps)
+    void AddPredicate(const std::string& column, TStatistics::ECompareOp op,
+                      const std::string& literal);
+    bool RowGroupMayMatch(size_t index) const;
+
 private:
+    std::string filename_;
+    FormatReaderOptions options_;
     BinaryReader reader_;
+    std::shared_ptr<const MappedFile> mapping_;
+    std::unique_ptr<UringReader> uring_;
     bool opened_ = false;
 
     uint32_t columnCount_ = 0;
+    uint32_t rowGroupCount_ = 0;
     uint64_t totalRowCount_ = 0;
     uint64_t footerOffset_ = 0;
 
@@ -44,12 +107,38 @@ private:
     std::vector<RowGroupMeta> rowGroupMetas_;
     size_t currentRowGroupIndex_ = 0;
 
+    std::vector<TPredicate> predicates_;
+    std::vector<size_t> predicateColumns_;
+
+    std::vector<size_t> allColumns_;
+
     void ValidateMagic();
     void ReadHeader();
     void ReadSchema();
     void ReadFooter();
-    Column ReadColumn(const std::string& name, Types::DataType type,
-                      size_t rowCount);
+
+    const RowGroupMeta& GetCheckedMeta(size_t index) const;
+    void SkipNonMatchingRowGroups();
+    Schema ProjectSchema(const std::vector<size_t>& columnIndices) const;
+
+    // Returns bytes of every requested chunk. Spans point into the mapping or
+    // into a read buffer; the buffer is shared through `owner` if it is
+    // given, otherwise a per-thread buffer is reused and spans live until the
+    // next fetch on the same thread.
+    std::vector<std::span<const char>> FetchChunks(
+        const RowGroupMeta& meta, const std::vector<size_t>& columnIndices,
+        std::shared_ptr<const void>* owner) const;
+
+    // Lays out the coalesced ranges of the requested chunks in `buffer` and
+    // appends the file reads that fill them. Spans are valid after the reads.
+    std::vector<std::span<const char>> PlanChunkReads(
+        const RowGroupMeta& meta, const std::vector<size_t>& columnIndices,
+        std::vector<char>& buffer, std::vector<ReadRequest>& reads) const;
+    void ExecuteReads(const std::vector<ReadRequest>& reads) const;
+
+    RowGroup DecodeRowGroup(
+        const RowGroupMeta& meta, const std::vector<size_t>& columnIndices,
+        Schema schema, const std::vector<std::span<const char>>& chunks) const;
 };
 
 }  // namespace Columnar::IO
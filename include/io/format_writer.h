@@ -4,21 +4,38 @@
 #include <core/row_group.h>
 #include <core/schema.h>
 #include <io/binary_io.h>
+#include <util/thread_pool.h>
 
+#include <deque>
+#include <future>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace Columnar::IO {
 
+struct FormatWriterOptions {
+    // row groups are encoded on this many worker threads, 0 encodes inline
+    size_t encodeThreads = 0;
+    // row groups submitted but not yet written, bounds memory in parallel
+    // mode (input batches and encoded bytes of each are held)
+    size_t maxInFlight = 4;
+};
+
+// Row groups are encoded (statistics, encodings) into memory and appended to
+// the file in submission order. With encodeThreads > 0 encoding runs on a
+// pool, WriteRowGroup blocks only when maxInFlight row groups are pending.
 class FormatWriter {
 public:
-    explicit FormatWriter(const std::string& filename);
+    explicit FormatWriter(const std::string& filename,
+                          FormatWriterOptions options = {});
 
     FormatWriter(const FormatWriter&) = delete;
     FormatWriter& operator=(const FormatWriter&) = delete;
 
     void Begin(const Schema& schema);
     void WriteRowGroup(const RowGroup& rowGroup);
+    void WriteRowGroup(RowGroup&& rowGroup);  // avoids a copy in parallel mode
     void End();
 
     size_t GetRowGroupCount() const;
@@ -27,17 +44,33 @@ public:
     ~FormatWriter();
 
 private:
+    // Serialized row group; chunk offsets are relative to its start
+    struct EncodedRowGroup {
+        std::vector<char> data;
+        uint32_t rowCount = 0;
+        std::vector<ColumnChunkMeta> columns;
+    };
+
     BinaryWriter writer_;
+    FormatWriterOptions options_;
     Schema schema_;
     std::vector<RowGroupMeta> rowGroupMetas_;
 
     size_t totalRowCount_ = 0;
+    uint64_t footerOffset_ = 0;
+
+    std::unique_ptr<ThreadPool> pool_;
+    std::deque<std::future<EncodedRowGroup>> pending_;
+
     bool begun_ = false;
     bool ended_ = false;
 
     void WriteHeader();
     void WriteSchema();
-    void WriteColumn(const Column& column);
+    void CheckWritable() const;
+    static EncodedRowGroup EncodeRowGroup(const Batch& batch);
+    void AppendRowGroup(EncodedRowGroup encoded);
+    void WritePending(size_t keep);
     void WriteFooter();
     void FinalizeHeader();
 };
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <core/batch.h>
+#include <core/schema.h>
+#include <io/mapped_file.h>
+#include <parser/csv_parser.h>
+#include <util/thread_pool.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Columnar::IO {
+
+struct ParallelCsvOptions {
+    // 0 means std::thread::hardware_concurrency()
+    size_t threads = 0;
+    // nominal byte range parsed by one task, cut at the next record start
+    size_t chunkSize = 8 << 20;
+    // ranges parsed or parsed but not yet returned, 0 means 2 * threads
+    size_t maxInFlight = 0;
+    // false returns batches in completion order
+    bool ordered = true;
+    Parser::CsvParserOptions csv;
+};
+
+// Maps the input, cuts it into byte ranges at record boundaries and parses
+// the ranges on a thread pool. Quoted fields may contain newlines: every
+// task counts the quotes of its own nominal chunk in parallel, then the
+// quote parity at each chunk start is passed from task to task, so no
+// thread scans the input serially. Batches do not span ranges, so the last
+// batch of every range may be smaller than kBatchSize.
+class ParallelCsvReader {
+public:
+    ParallelCsvReader(const std::string& filename, const Schema& schema,
+                      ParallelCsvOptions options = {});
+    ~ParallelCsvReader();
+
+    ParallelCsvReader(const ParallelCsvReader&) = delete;
+    ParallelCsvReader& operator=(const ParallelCsvReader&) = delete;
+
+    std::optional<Batch> ReadBatch();
+
+    const Schema& GetSchema() const;
+    size_t GetTotalRowsRead() const;
+
+private:
+    struct TRangeResult {
+        std::vector<Batch> batches;
+        std::exception_ptr error;
+    };
+
+    MappedFile file_;
+    std::string_view data_;
+    Schema schema_;
+    ParallelCsvOptions options_;
+    size_t totalRowsRead_ = 0;
+
+    size_t rangeCount_ = 0;     // nominal chunks of chunkSize bytes
+    size_t submitted_ = 0;      // ranges submitted so far
+    size_t nextToReturn_ = 0;   // next range index in ordered mode
+    size_t inFlight_ = 0;       // submitted and not yet taken by ReadBatch
+    std::deque<Batch> ready_;
+
+    std::mutex mutex_;
+    std::condition_variable completed_;
+    std::map<size_t, TRangeResult> results_;
+    bool stopping_ = false;
+
+    // quote parity at the start of the next chunk, published by its
+    // predecessor
+    std::condition_variable parityReady_;
+    std::map<size_t, bool> startParity_;
+
+    std::unique_ptr<ThreadPool> pool_;  // last: joined before the rest dies
+
+    void SubmitRanges();
+    bool TakeResult();
+    size_t GetCut(size_t index) const;
+    std::optional<std::pair<size_t, size_t>> FindRange(size_t index);
+    std::vector<Batch> ParseRange(size_t begin, size_t end) const;
+};
+
+}  // namespace Columnar::IO
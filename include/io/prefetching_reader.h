@@ -0,0 +1,71 @@
+#pragma once
+
+#include <io/format_reader.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace Columnar::IO {
+
+struct PrefetchOptions {
+    // max number of decoded row groups waiting in the queue
+    size_t depth = 2;
+    // soft cap on queued data, counted in on-disk chunk bytes. A single row
+    // group larger than the cap is still read once the queue is empty.
+    uint64_t memoryLimit = 256ull << 20;
+    // schema indices of columns to read, all columns if empty
+    std::vector<size_t> projection;
+};
+
+// Reads and decodes the row groups of an opened FormatReader in order on a
+// background thread, so I/O and decoding overlap with the caller's work.
+// Predicates set on the reader are honoured. The reader must not be used
+// directly after being handed over.
+class PrefetchingReader {
+public:
+    explicit PrefetchingReader(FormatReader reader,
+                               PrefetchOptions options = {});
+    ~PrefetchingReader();
+
+    PrefetchingReader(const PrefetchingReader&) = delete;
+    PrefetchingReader& operator=(const PrefetchingReader&) = delete;
+
+    // Next matching row group, nullopt once the file is exhausted.
+    // Errors of the background thread are rethrown here.
+    std::optional<RowGroup> ReadRowGroup();
+    std::optional<Batch> ReadBatch();
+
+    const Schema& GetSchema() const;
+
+private:
+    struct TQueued {
+        RowGroup rowGroup;
+        uint64_t bytes = 0;
+    };
+
+    FormatReader reader_;
+    PrefetchOptions options_;
+    Schema schema_;
+
+    std::mutex mutex_;
+    std::condition_variable produced_;
+    std::condition_variable consumed_;
+    std::deque<TQueued> queue_;
+    uint64_t queuedBytes_ = 0;
+    bool finished_ = false;
+    bool stopping_ = false;
+    std::exception_ptr error_;
+
+    std::thread worker_;
+
+    void Run();
+    uint64_t GetEncodedSize(size_t index) const;
+};
+
+}  // namespace Columnar::IO
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+
+namespace Columnar::IO {
+
+// One positional read into caller-owned memory
+struct ReadRequest {
+    uint64_t offset = 0;
+    size_t size = 0;
+    char* destination = nullptr;
+};
+
+// Linux io_uring read backend. Submits up to `queueDepth` reads at once and
+// completes them out of order, so many chunks (also of different row groups)
+// are fetched from one thread with a deep device queue. Talks to the kernel
+// through raw syscalls, no liburing dependency.
+class UringReader {
+public:
+    static constexpr unsigned kDefaultQueueDepth = 64;
+
+    // Throws std::runtime_error if io_uring is unavailable (old kernel,
+    // disabled by seccomp, non-Linux build)
+    UringReader(const std::string& filename,
+                unsigned queueDepth = kDefaultQueueDepth);
+    ~UringReader();
+
+    UringReader(const UringReader&) = delete;
+    UringReader& operator=(const UringReader&) = delete;
+
+    // Returns when every request is fully read, short reads are resubmitted.
+    // Concurrent callers are serialized on the ring.
+    void Read(std::span<const ReadRequest> requests);
+
+private:
+    int fileFd_ = -1;
+    int ringFd_ = -1;
+    unsigned queueDepth_ = 0;
+    std::mutex mutex_;
+
+    void* sqRing_ = nullptr;
+    size_t sqRingSize_ = 0;
+    void* cqRing_ = nullptr;
+    size_t cqRingSize_ = 0;
+    void* sqes_ = nullptr;
+    size_t sqesSize_ = 0;
+
+    unsigned* sqTail_ = nullptr;
+    unsigned sqMask_ = 0;
+    unsigned* sqArray_ = nullptr;
+    unsigned* cqHead_ = nullptr;
+    unsigned* cqTail_ = nullptr;
+    unsigned cqMask_ = 0;
+    void* cqes_ = nullptr;
+
+    void Close();
+};
+
+}  // namespace Columnar::IO
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <core/column.h>
+#include <parser/csv_tokenizer.h>
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace Columnar::Parser {
+
+// Parses field `fieldOffset` of every listed record of a tokenized block
+// straight into `column`: one type dispatch per column, from_chars into the
+// typed buffer, strings appended to the character blob as views. No heap
+// allocation per cell. `recordFirstFields` are indices into
+// tokens.fieldEnds of the first field of each record. Empty fields of
+// non-STRING columns are appended as NULL.
+void AppendCsvColumn(std::string_view data, const CsvTokens& tokens,
+                     std::span<const uint32_t> recordFirstFields,
+                     size_t fieldOffset, Column& column,
+                     const CsvParserOptions& options = {});
+
+}  // namespace Columnar::Parser
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace Columnar::Parser {
@@ -13,6 +15,12 @@ struct CsvParserOptions {
 std::vector<std::string> ParseCsvLine(const std::string& line,
                                       const CsvParserOptions& options = {});
 
+// Offset just past the first unquoted newline at or after `from`, i.e. the
+// next record start. `inQuotes` tells whether `from` lies inside a quoted
+// field. data.size() if there is none.
+size_t FindRecordStart(std::string_view data, size_t from, bool inQuotes,
+                       const CsvParserOptions& options = {});
+
 std::string EscapeCsvField(const std::string& field,
                            const CsvParserOptions& options = {});
 
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <parser/csv_parser.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Columnar::Parser {
+
+// Field boundaries of a block of CSV records. Field i spans
+// [i == 0 ? 0 : fieldEnds[i - 1] + 1, fieldEnds[i]) of the tokenized data,
+// raw (still quoted). Quoted fields may contain delimiters and newlines.
+struct CsvTokens {
+    // offset of the delimiter, newline or end of data closing each field
+    std::vector<uint32_t> fieldEnds;
+    // number of fields up to and including each record
+    std::vector<uint32_t> recordEnds;
+
+    size_t GetRecordCount() const { return recordEnds.size(); }
+
+    size_t GetFieldBegin(size_t field) const {
+        return field == 0 ? 0 : fieldEnds[field - 1] + 1;
+    }
+
+    void Clear() {
+        fieldEnds.clear();
+        recordEnds.clear();
+    }
+};
+
+enum class CsvTokenizerIsa : uint8_t {
+    SCALAR = 0,
+    SSE2 = 1,
+    AVX2 = 2
+};
+
+// Best implementation supported by the running CPU
+CsvTokenizerIsa GetCsvTokenizerIsa();
+
+// Classifies 64 bytes at a time into quote/delimiter/newline bitmasks,
+// derives the quoted regions with a prefix XOR over the quote mask and emits
+// every unquoted delimiter and newline. Data must be smaller than 4 GiB.
+void TokenizeCsv(std::string_view data, CsvTokens& tokens,
+                 const CsvParserOptions& options = {});
+void TokenizeCsv(std::string_view data, CsvTokens& tokens,
+                 const CsvParserOptions& options, CsvTokenizerIsa isa);
+
+// Value of a raw field: outer quotes removed, doubled quotes collapsed, CRs
+// outside quotes dropped. Points into `data` unless unescaping was needed,
+// then into `scratch`.
+std::string_view UnescapeCsvField(std::string_view raw, std::string& scratch,
+                                  const CsvParserOptions& options = {});
+
+}  // namespace Columnar::Parser
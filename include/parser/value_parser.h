@@ -2,9 +2,33 @@
 
 #include <core/types.h>
 #include <string>
+#include <string_view>
 
 namespace Columnar::Parser {
 
+// Allocation-free parsers of a single field, surrounding whitespace is
+// ignored. Throw std::invalid_argument on malformed input.
+template <typename T>
+T ParseInteger(std::string_view str);  // int16_t, int32_t, int64_t
+bool ParseBool(std::string_view str);
+int32_t ParseDate(std::string_view str);       // YYYY-MM-DD, days since epoch
+int64_t ParseTimestamp(std::string_view str);  // seconds since epoch, UTC
+
+// Civil calendar (proleptic Gregorian, UTC) <-> days since 1970-01-01
+int32_t DaysFromCivil(int32_t year, unsigned month, unsigned day);
+void CivilFromDays(int32_t days, int32_t& year, unsigned& month,
+                   unsigned& day);
+
+constexpr size_t kDateLength = 10;       // YYYY-MM-DD
+constexpr size_t kTimestampLength = 19;  // YYYY-MM-DD HH:MM:SS
+
+// Write exactly kDateLength / kTimestampLength chars and return the end.
+// Years outside 0000-9999 throw std::out_of_range.
+char* FormatDate(int32_t daysSinceEpoch, char* out);
+char* FormatTimestamp(int64_t secondsSinceEpoch, char* out);
+std::string FormatDate(int32_t daysSinceEpoch);
+std::string FormatTimestamp(int64_t secondsSinceEpoch);
+
 Types::AnyColumnType ParseValue(const std::string& str, Types::DataType type);
 
 std::string ValueToString(const Types::AnyColumnType& value,
@@ -1,16 +1,17 @@
 #pragma once
 
+#include <core/column.h>
 #include <core/types.h>
 #include <optional>
+#include <string>
 #include <variant>
 
-namespace NColumnar {
+namespace Columnar {
 
 struct TStatistics {
     using TMinMax = std::variant<std::monostate, int16_t, int32_t, int64_t,
                                  bool, std::string>;
-    
-    // TODO: use enum below for predicate pushdown
+
     enum class ECompareOp {
         Equal,
         NotEqual,
@@ -20,6 +21,9 @@ struct TStatistics {
         GreaterOrEqual
     };
 
+    // longer string min/max values are not kept, they would bloat the footer
+    static constexpr size_t kMaxStringMinMaxLength = 64;
+
     size_t rowCount = 0;
     size_t nullCount = 0;
 
@@ -35,9 +39,27 @@ struct TStatistics {
 public:
     TStatistics() = default;
 
-    explicit TStatistics(NTypes::EDataType type);
+    explicit TStatistics(Types::DataType type);
+
+    static TStatistics Compute(const Column& column);
+
+    bool HasMinMax() const;
 
-    // TODO: implement statistics methods
+    // Returns false only if no row can satisfy `value <op> constant`, so the
+    // chunk can be skipped. Unknown statistics always may match.
+    bool MayMatch(ECompareOp op, const TMinMax& constant) const;
 };
 
-}  // namespace NColumnar
\ No newline at end of file
+// Simple `column <op> constant` filter used for row group skipping
+struct TPredicate {
+    std::string column;
+    TStatistics::ECompareOp op;
+    TStatistics::TMinMax value;
+};
+
+// Three-way comparison of two values, integer types are compared by value
+// regardless of width. Returns nullopt for incomparable values.
+std::optional<int> CompareMinMax(const TStatistics::TMinMax& lhs,
+                                 const TStatistics::TMinMax& rhs);
+
+}  // namespace Columnar
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Columnar {
+
+// Fixed set of worker threads executing submitted tasks in FIFO order.
+// Results and exceptions are delivered through std::future.
+class ThreadPool {
+public:
+    // 0 means std::thread::hardware_concurrency()
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template <typename F>
+    std::future<std::invoke_result_t<F>> Submit(F&& task) {
+        using TResult = std::invoke_result_t<F>;
+
+        auto packaged = std::make_shared<std::packaged_task<TResult()>>(
+            std::forward<F>(task));
+        std::future<TResult> result = packaged->get_future();
+        Enqueue([packaged] { (*packaged)(); });
+        return result;
+    }
+
+    size_t GetThreadCount() const;
+
+private:
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    bool stopping_ = false;
+
+    void Enqueue(std::function<void()> task);
+    void Run();
+};
+
+}  // namespace Columnar
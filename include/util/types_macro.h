@@ -18,10 +18,10 @@ namespace NColumnar::NTypes {
 // Declaration macroses
 
 #define DECLARE_VISITOR_OP_CONST(TYPE, RETURN_TYPE) \
-    RETURN_TYPE operator()(const std::vector<TYPE>& data) const;
+    RETURN_TYPE operator()(const ColumnVector<TYPE>& data) const;
 
 #define DECLARE_VISITOR_OP_MUTUABLE(TYPE, RETURN_TYPE) \
-    RETURN_TYPE operator()(std::vector<TYPE>& data) const;
+    RETURN_TYPE operator()(ColumnVector<TYPE>& data) const;
 
 #define DECLARE_CONST_VISITOR_FOR_ALL_TYPES(RETURN_TYPE) \
     DECLARE_VISITOR_OP_CONST(int16_t, RETURN_TYPE)       \
@@ -40,14 +40,14 @@ namespace NColumnar::NTypes {
 // Impl macroses
 
 #define IMPL_VISITOR_OP_CONST(VISITOR_NAME, TYPE, RETURN_TYPE, BODY)    \
-    RETURN_TYPE VISITOR_NAME::operator()(const std::vector<TYPE>& data) \
-        const {                                                         \
-        BODY                                                            \
+    RETURN_TYPE VISITOR_NAME::operator()(const ColumnVector<TYPE>& data) \
+        const {                                                           \
+        BODY                                                              \
     }
 
 #define IMPL_VISITOR_OP_MUTABLE(VISITOR_NAME, TYPE, RETURN_TYPE, BODY)    \
-    RETURN_TYPE VISITOR_NAME::operator()(std::vector<TYPE>& data) const { \
-        BODY                                                              \
+    RETURN_TYPE VISITOR_NAME::operator()(ColumnVector<TYPE>& data) const { \
+        BODY                                                               \
     }
 
 #define IMPL_CONST_VISITOR_FOR_ALL_TYPES(VISITOR_NAME, RETURN_TYPE, BODY) \
@@ -0,0 +1,389 @@
+#include <compute/aggregate.h>
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define COLUMNAR_AGGREGATE_X86 1
+#endif
+
+namespace Columnar::Compute {
+
+namespace {
+
+// Longest run handed to a kernel at once, keeps the 64-bit SIMD lane sums
+// far from overflowing
+constexpr size_t kMaxRunLength = size_t{1} << 30;
+
+template <typename T>
+struct IntegerPartial {
+    Int128 sum = 0;
+    T min = std::numeric_limits<T>::max();
+    T max = std::numeric_limits<T>::min();
+    size_t count = 0;
+
+    void Add(T value) {
+        sum += value;
+        min = std::min(min, value);
+        max = std::max(max, value);
+        ++count;
+    }
+};
+
+template <typename T>
+using ReduceFn = void (*)(const T* data, size_t count,
+                          IntegerPartial<T>& partial);
+
+template <typename T>
+void ReduceScalar(const T* data, size_t count, IntegerPartial<T>& partial) {
+    for (size_t i = 0; i < count; ++i) {
+        partial.Add(data[i]);
+    }
+}
+
+#ifdef COLUMNAR_AGGREGATE_X86
+
+// INT64 lanes are summed as unsigned 32-bit halves plus the count of negative
+// values, none of which can overflow within kMaxRunLength rows:
+// sum = high * 2^32 + low - negatives * 2^64
+template <typename T>
+void MergeLanes(const int64_t* low, const int64_t* high,
+                const int64_t* negative, size_t lanes, const T* min,
+                const T* max, size_t minMaxLanes, IntegerPartial<T>& partial) {
+    for (size_t j = 0; j < lanes; ++j) {
+        if constexpr (sizeof(T) == 8) {
+            partial.sum += static_cast<Int128>(static_cast<uint64_t>(low[j]));
+            partial.sum += static_cast<Int128>(static_cast<uint64_t>(high[j]))
+                           << 32;
+            partial.sum += static_cast<Int128>(negative[j]) *
+                           (static_cast<Int128>(1) << 64);
+        } else {
+            partial.sum += low[j];
+        }
+    }
+    for (size_t j = 0; j < minMaxLanes; ++j) {
+        partial.min = std::min(partial.min, min[j]);
+        partial.max = std::max(partial.max, max[j]);
+    }
+}
+
+template <typename T>
+__attribute__((target("avx2"))) void ReduceAvx2(const T* data, size_t count,
+                                                IntegerPartial<T>& partial) {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    size_t simdCount = count / kLanes * kLanes;
+
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i low = zero;
+    __m256i high = zero;
+    __m256i negative = zero;
+    __m256i min;
+    __m256i max;
+    if constexpr (sizeof(T) == 2) {
+        min = _mm256_set1_epi16(partial.min);
+        max = _mm256_set1_epi16(partial.max);
+    } else if constexpr (sizeof(T) == 4) {
+        min = _mm256_set1_epi32(partial.min);
+        max = _mm256_set1_epi32(partial.max);
+    } else {
+        min = _mm256_set1_epi64x(partial.min);
+        max = _mm256_set1_epi64x(partial.max);
+    }
+
+    for (size_t i = 0; i < simdCount; i += kLanes) {
+        __m256i v =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+
+        if constexpr (sizeof(T) == 2) {
+            min = _mm256_min_epi16(min, v);
+            max = _mm256_max_epi16(max, v);
+            // adjacent pairs summed into int32, then widened to int64
+            __m256i pairs = _mm256_madd_epi16(v, _mm256_set1_epi16(1));
+            low = _mm256_add_epi64(
+                low, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(pairs)));
+            low = _mm256_add_epi64(
+                low, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(pairs, 1)));
+        } else if constexpr (sizeof(T) == 4) {
+            min = _mm256_min_epi32(min, v);
+            max = _mm256_max_epi32(max, v);
+            low = _mm256_add_epi64(
+                low, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+            low = _mm256_add_epi64(
+                low, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+        } else {
+            // AVX2 has no 64-bit min/max
+            min = _mm256_blendv_epi8(min, v, _mm256_cmpgt_epi64(min, v));
+            max = _mm256_blendv_epi8(max, v, _mm256_cmpgt_epi64(v, max));
+            low = _mm256_add_epi64(
+                low, _mm256_and_si256(v, _mm256_set1_epi64x(0xFFFFFFFF)));
+            high = _mm256_add_epi64(high, _mm256_srli_epi64(v, 32));
+            negative = _mm256_add_epi64(negative, _mm256_cmpgt_epi64(zero, v));
+        }
+    }
+
+    int64_t lowLanes[4];
+    int64_t highLanes[4];
+    int64_t negativeLanes[4];
+    T minLanes[kLanes];
+    T maxLanes[kLanes];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lowLanes), low);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(highLanes), high);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(negativeLanes), negative);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(minLanes), min);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(maxLanes), max);
+    MergeLanes(lowLanes, highLanes, negativeLanes, 4, minLanes, maxLanes,
+               kLanes, partial);
+    partial.count += simdCount;
+
+    ReduceScalar(data + simdCount, count - simdCount, partial);
+}
+
+template <typename T>
+__attribute__((target("avx512f,avx512bw"))) void ReduceAvx512(
+    const T* data, size_t count, IntegerPartial<T>& partial) {
+    constexpr size_t kLanes = 64 / sizeof(T);
+    size_t simdCount = count / kLanes * kLanes;
+
+    __m512i low = _mm512_setzero_si512();
+    __m512i high = _mm512_setzero_si512();
+    __m512i negative = _mm512_setzero_si512();
+    __m512i min;
+    __m512i max;
+    if constexpr (sizeof(T) == 2) {
+        min = _mm512_set1_epi16(partial.min);
+        max = _mm512_set1_epi16(partial.max);
+    } else if constexpr (sizeof(T) == 4) {
+        min = _mm512_set1_epi32(partial.min);
+        max = _mm512_set1_epi32(partial.max);
+    } else {
+        min = _mm512_set1_epi64(partial.min);
+        max = _mm512_set1_epi64(partial.max);
+    }
+
+    for (size_t i = 0; i < simdCount; i += kLanes) {
+        __m512i v = _mm512_loadu_si512(data + i);
+
+        if constexpr (sizeof(T) == 2) {
+            min = _mm512_min_epi16(min, v);
+            max = _mm512_max_epi16(max, v);
+            __m512i pairs = _mm512_madd_epi16(v, _mm512_set1_epi16(1));
+            low = _mm512_add_epi64(
+                low, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(pairs)));
+            __m256i upper = _mm512_extracti64x4_epi64(pairs, 1);
+            low = _mm512_add_epi64(low, _mm512_cvtepi32_epi64(upper));
+        } else if constexpr (sizeof(T) == 4) {
+            min = _mm512_min_epi32(min, v);
+            max = _mm512_max_epi32(max, v);
+            low = _mm512_add_epi64(
+                low, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(v)));
+            low = _mm512_add_epi64(
+                low, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(v, 1)));
+        } else {
+            min = _mm512_min_epi64(min, v);
+            max = _mm512_max_epi64(max, v);
+            low = _mm512_add_epi64(
+                low, _mm512_and_si512(v, _mm512_set1_epi64(0xFFFFFFFF)));
+            high = _mm512_add_epi64(high, _mm512_srli_epi64(v, 32));
+            // -1 for negative values
+            negative = _mm512_add_epi64(negative, _mm512_srai_epi64(v, 63));
+        }
+    }
+
+    int64_t lowLanes[8];
+    int64_t highLanes[8];
+    int64_t negativeLanes[8];
+    T minLanes[kLanes];
+    T maxLanes[kLanes];
+    _mm512_storeu_si512(lowLanes, low);
+    _mm512_storeu_si512(highLanes, high);
+    _mm512_storeu_si512(negativeLanes, negative);
+    _mm512_storeu_si512(minLanes, min);
+    _mm512_storeu_si512(maxLanes, max);
+    MergeLanes(lowLanes, highLanes, negativeLanes, 8, minLanes, maxLanes,
+               kLanes, partial);
+    partial.count += simdCount;
+
+    ReduceScalar(data + simdCount, count - simdCount, partial);
+}
+
+#endif
+
+template <typename T>
+ReduceFn<T> GetReduceKernel(FilterIsa isa) {
+    switch (isa) {
+#ifdef COLUMNAR_AGGREGATE_X86
+        case FilterIsa::AVX512:
+            return ReduceAvx512<T>;
+        case FilterIsa::AVX2:
+            return ReduceAvx2<T>;
+#endif
+        case FilterIsa::SCALAR:
+            return ReduceScalar<T>;
+        default:
+            throw std::invalid_argument("Aggregate ISA is not supported");
+    }
+}
+
+// Runs of fully selected 64-row blocks go to the SIMD kernel, the rows of
+// partially selected blocks are added one by one
+template <typename T>
+void AggregateIntegers(const std::vector<T>& vec, const Bitmap* mask,
+                       FilterIsa isa, AggregateResult& result) {
+    ReduceFn<T> kernel = GetReduceKernel<T>(isa);
+    IntegerPartial<T> partial;
+
+    auto reduceRun = [&](size_t begin, size_t end) {
+        while (begin < end) {
+            size_t length = std::min(end - begin, kMaxRunLength);
+            kernel(vec.data() + begin, length, partial);
+            begin += length;
+        }
+    };
+
+    if (!mask) {
+        reduceRun(0, vec.size());
+    } else {
+        auto words = mask->GetWords();
+        std::optional<size_t> runBegin;
+        for (size_t w = 0; w < words.size(); ++w) {
+            size_t begin = w * Bitmap::kWordBits;
+            size_t bits = std::min(vec.size() - begin, Bitmap::kWordBits);
+            uint64_t full = bits == Bitmap::kWordBits
+                                ? ~uint64_t{0}
+                                : (uint64_t{1} << bits) - 1;
+
+            if (words[w] == full) {
+                if (!runBegin) {
+                    runBegin = begin;
+                }
+                continue;
+            }
+            if (runBegin) {
+                reduceRun(*runBegin, begin);
+                runBegin.reset();
+            }
+            for (uint64_t word = words[w]; word != 0; word &= word - 1) {
+                partial.Add(vec[begin + std::countr_zero(word)]);
+            }
+        }
+        if (runBegin) {
+            reduceRun(*runBegin, vec.size());
+        }
+    }
+
+    result.count = partial.count;
+    result.sum = partial.sum;
+    if (partial.count > 0) {
+        result.min = partial.min;
+        result.max = partial.max;
+    }
+}
+
+void AggregateBools(const Bitmap& vec, const Bitmap* mask,
+                    AggregateResult& result) {
+    Bitmap values = vec;
+    if (mask) {
+        values &= *mask;
+    }
+
+    result.count = mask ? mask->CountSet() : vec.size();
+    result.sum = values.CountSet();
+    if (result.count > 0) {
+        result.min = result.sum == static_cast<Int128>(result.count);
+        result.max = result.sum > 0;
+    }
+}
+
+void AggregateStrings(const StringVector& vec, const Bitmap* mask,
+                      AggregateResult& result) {
+    std::optional<std::string_view> min;
+    std::optional<std::string_view> max;
+    for (size_t i = 0; i < vec.size(); ++i) {
+        if (mask && !(*mask)[i]) {
+            continue;
+        }
+
+        std::string_view value = vec[i];
+        if (!min) {
+            min = max = value;
+        }
+        min = std::min(*min, value);
+        max = std::max(*max, value);
+        ++result.count;
+    }
+
+    if (min) {
+        result.min = std::string(*min);
+        result.max = std::string(*max);
+    }
+}
+
+}  // namespace
+
+std::optional<double> AggregateResult::GetAverage() const {
+    if (count == 0) {
+        return std::nullopt;
+    }
+    return static_cast<double>(sum) / static_cast<double>(count);
+}
+
+AggregateResult Aggregate(const Column& column, const Bitmap* mask) {
+    return Aggregate(column, mask, GetFilterIsa());
+}
+
+AggregateResult Aggregate(const Column& column, const Bitmap* mask,
+                          FilterIsa isa) {
+    if (static_cast<uint8_t>(isa) > static_cast<uint8_t>(GetFilterIsa())) {
+        throw std::invalid_argument(
+            "Aggregate ISA is not supported by the CPU");
+    }
+    if (mask && mask->size() != column.GetRowCount()) {
+        throw std::invalid_argument(
+            "Aggregate mask size mismatch: " + std::to_string(mask->size()) +
+            " bits for " + std::to_string(column.GetRowCount()) + " rows");
+    }
+
+    // NULL rows are dropped from the mask
+    std::optional<Bitmap> combined;
+    if (const Bitmap* validity = column.GetValidity()) {
+        if (mask) {
+            combined = *mask;
+            *combined &= *validity;
+            mask = &*combined;
+        } else {
+            mask = validity;
+        }
+    }
+
+    AggregateResult result;
+    std::visit(Types::overloaded{
+                   [&](const Bitmap& vec) {
+                       AggregateBools(vec, mask, result);
+                   },
+                   [&](const StringVector& vec) {
+                       AggregateStrings(vec, mask, result);
+                   },
+                   [&](const auto& vec) {
+                       AggregateIntegers(vec, mask, isa, result);
+                   }},
+               column.GetData());
+    return result;
+}
+
+AggregateResult Aggregate(const Batch& batch, size_t columnIndex) {
+    const Column& column = batch.GetColumn(columnIndex);
+    if (!batch.HasSelection()) {
+        return Aggregate(column);
+    }
+
+    Bitmap mask = batch.GetSelectionMask();
+    return Aggregate(column, &mask);
+}
+
+}  // namespace Columnar::Compute
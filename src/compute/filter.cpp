@@ -0,0 +1,498 @@
+#include <compute/filter.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define COLUMNAR_FILTER_X86 1
+#endif
+
+namespace Columnar::Compute {
+
+namespace {
+
+constexpr size_t kBlockSize = Bitmap::kWordBits;
+
+// Every operator is `a == b` or `a > b`, possibly with swapped operands and
+// a negated result
+struct Predicate {
+    bool equal = false;
+    bool swap = false;
+    bool negate = false;
+};
+
+Predicate GetPredicate(ECompareOp op) {
+    switch (op) {
+        case ECompareOp::Equal:
+            return {true, false, false};
+        case ECompareOp::NotEqual:
+            return {true, false, true};
+        case ECompareOp::Greater:
+            return {false, false, false};
+        case ECompareOp::LessOrEqual:
+            return {false, false, true};
+        case ECompareOp::Less:
+            return {false, true, false};
+        case ECompareOp::GreaterOrEqual:
+            return {false, true, true};
+    }
+    throw std::invalid_argument("Unknown comparison operator");
+}
+
+template <typename T>
+using KernelFn = void (*)(const T* lhs, const T* rhs, size_t count,
+                          uint64_t* words);
+
+// `rhs` is a column (kStep = 1) or a single constant (kStep = 0). Words
+// past `count` bits are left for the caller to clear.
+template <typename T, bool kEqual, bool kSwap, size_t kStep>
+void CompareScalar(const T* lhs, const T* rhs, size_t count,
+                   uint64_t* words) {
+    for (size_t begin = 0; begin < count; begin += kBlockSize) {
+        size_t end = std::min(count, begin + kBlockSize);
+        uint64_t word = 0;
+        for (size_t i = begin; i < end; ++i) {
+            T a = lhs[i];
+            T b = rhs[i * kStep];
+            bool match = kEqual ? a == b : (kSwap ? b > a : a > b);
+            word |= uint64_t{match} << (i - begin);
+        }
+        words[begin / kBlockSize] = word;
+    }
+}
+
+#ifdef COLUMNAR_FILTER_X86
+
+template <typename T, bool kEqual, bool kSwap, size_t kStep>
+__attribute__((target("avx2"))) void CompareAvx2(const T* lhs, const T* rhs,
+                                                 size_t count,
+                                                 uint64_t* words) {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    size_t blocks = count / kBlockSize;
+
+    __m256i constant;
+    if constexpr (sizeof(T) == 2) {
+        constant = _mm256_set1_epi16(rhs[0]);
+    } else if constexpr (sizeof(T) == 4) {
+        constant = _mm256_set1_epi32(rhs[0]);
+    } else {
+        constant = _mm256_set1_epi64x(rhs[0]);
+    }
+
+    for (size_t block = 0; block < blocks; ++block) {
+        uint64_t word = 0;
+        // int16 lanes are compared two registers at a time
+        constexpr size_t kStride = sizeof(T) == 2 ? 2 * kLanes : kLanes;
+        for (size_t j = 0; j < kBlockSize; j += kStride) {
+            size_t i = block * kBlockSize + j;
+            __m256i a = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(lhs + i));
+            __m256i b = kStep ? _mm256_loadu_si256(
+                                    reinterpret_cast<const __m256i*>(rhs + i))
+                              : constant;
+
+            if constexpr (sizeof(T) == 2) {
+                __m256i a2 = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(lhs + i + kLanes));
+                __m256i b2 =
+                    kStep ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+                                rhs + i + kLanes))
+                          : constant;
+                __m256i r1 = kEqual ? _mm256_cmpeq_epi16(a, b)
+                                    : (kSwap ? _mm256_cmpgt_epi16(b, a)
+                                             : _mm256_cmpgt_epi16(a, b));
+                __m256i r2 = kEqual ? _mm256_cmpeq_epi16(a2, b2)
+                                    : (kSwap ? _mm256_cmpgt_epi16(b2, a2)
+                                             : _mm256_cmpgt_epi16(a2, b2));
+                // packs interleaves 128-bit halves, the permute restores order
+                __m256i packed = _mm256_permute4x64_epi64(
+                    _mm256_packs_epi16(r1, r2), 0xD8);
+                word |= uint64_t{static_cast<uint32_t>(
+                            _mm256_movemask_epi8(packed))}
+                        << j;
+            } else if constexpr (sizeof(T) == 4) {
+                __m256i r = kEqual ? _mm256_cmpeq_epi32(a, b)
+                                   : (kSwap ? _mm256_cmpgt_epi32(b, a)
+                                            : _mm256_cmpgt_epi32(a, b));
+                word |= uint64_t{static_cast<uint32_t>(
+                            _mm256_movemask_ps(_mm256_castsi256_ps(r)))}
+                        << j;
+            } else {
+                __m256i r = kEqual ? _mm256_cmpeq_epi64(a, b)
+                                   : (kSwap ? _mm256_cmpgt_epi64(b, a)
+                                            : _mm256_cmpgt_epi64(a, b));
+                word |= uint64_t{static_cast<uint32_t>(
+                            _mm256_movemask_pd(_mm256_castsi256_pd(r)))}
+                        << j;
+            }
+        }
+        words[block] = word;
+    }
+
+    size_t done = blocks * kBlockSize;
+    CompareScalar<T, kEqual, kSwap, kStep>(lhs + done, rhs + done * kStep,
+                                           count - done, words + blocks);
+}
+
+template <typename T, bool kEqual, bool kSwap, size_t kStep>
+__attribute__((target("avx512f,avx512bw"))) void CompareAvx512(
+    const T* lhs, const T* rhs, size_t count, uint64_t* words) {
+    constexpr size_t kLanes = 64 / sizeof(T);
+    size_t blocks = count / kBlockSize;
+
+    __m512i constant;
+    if constexpr (sizeof(T) == 2) {
+        constant = _mm512_set1_epi16(rhs[0]);
+    } else if constexpr (sizeof(T) == 4) {
+        constant = _mm512_set1_epi32(rhs[0]);
+    } else {
+        constant = _mm512_set1_epi64(rhs[0]);
+    }
+
+    for (size_t block = 0; block < blocks; ++block) {
+        uint64_t word = 0;
+        for (size_t j = 0; j < kBlockSize; j += kLanes) {
+            size_t i = block * kBlockSize + j;
+            __m512i a = _mm512_loadu_si512(lhs + i);
+            __m512i b = kStep ? _mm512_loadu_si512(rhs + i) : constant;
+            if (kSwap) {
+                std::swap(a, b);
+            }
+
+            uint64_t mask;
+            if constexpr (sizeof(T) == 2) {
+                mask = kEqual ? _mm512_cmpeq_epi16_mask(a, b)
+                              : _mm512_cmpgt_epi16_mask(a, b);
+            } else if constexpr (sizeof(T) == 4) {
+                mask = kEqual ? _mm512_cmpeq_epi32_mask(a, b)
+                              : _mm512_cmpgt_epi32_mask(a, b);
+            } else {
+                mask = kEqual ? _mm512_cmpeq_epi64_mask(a, b)
+                              : _mm512_cmpgt_epi64_mask(a, b);
+            }
+            word |= mask << j;
+        }
+        words[block] = word;
+    }
+
+    size_t done = blocks * kBlockSize;
+    CompareScalar<T, kEqual, kSwap, kStep>(lhs + done, rhs + done * kStep,
+                                           count - done, words + blocks);
+}
+
+#endif
+
+template <typename T, bool kEqual, bool kSwap, size_t kStep>
+KernelFn<T> GetKernel(FilterIsa isa) {
+    switch (isa) {
+#ifdef COLUMNAR_FILTER_X86
+        case FilterIsa::AVX512:
+            return CompareAvx512<T, kEqual, kSwap, kStep>;
+        case FilterIsa::AVX2:
+            return CompareAvx2<T, kEqual, kSwap, kStep>;
+#endif
+        case FilterIsa::SCALAR:
+            return CompareScalar<T, kEqual, kSwap, kStep>;
+        default:
+            throw std::invalid_argument("Filter ISA is not supported");
+    }
+}
+
+template <typename T, size_t kStep>
+Bitmap CompareIntegers(const T* lhs, const T* rhs, size_t count,
+                       ECompareOp op, FilterIsa isa) {
+    Predicate predicate = GetPredicate(op);
+
+    KernelFn<T> kernel;
+    if (predicate.equal) {
+        kernel = GetKernel<T, true, false, kStep>(isa);
+    } else if (predicate.swap) {
+        kernel = GetKernel<T, false, true, kStep>(isa);
+    } else {
+        kernel = GetKernel<T, false, false, kStep>(isa);
+    }
+
+    std::vector<uint64_t> words(Bitmap::GetWordCount(count));
+    if (count > 0) {
+        kernel(lhs, rhs, count, words.data());
+    }
+    if (predicate.negate) {
+        for (uint64_t& word : words) {
+            word = ~word;
+        }
+    }
+    return Bitmap(std::move(words), count);
+}
+
+// Result for an integer constant outside the range of the column type
+Bitmap CompareOutOfRange(size_t count, ECompareOp op, bool aboveMax) {
+    switch (op) {
+        case ECompareOp::Equal:
+            return Bitmap(count, false);
+        case ECompareOp::NotEqual:
+            return Bitmap(count, true);
+        case ECompareOp::Less:
+        case ECompareOp::LessOrEqual:
+            return Bitmap(count, aboveMax);
+        case ECompareOp::Greater:
+        case ECompareOp::GreaterOrEqual:
+            return Bitmap(count, !aboveMax);
+    }
+    throw std::invalid_argument("Unknown comparison operator");
+}
+
+template <typename T>
+Bitmap CompareIntegerConstant(const std::vector<T>& vec, ECompareOp op,
+                              int64_t constant, FilterIsa isa) {
+    if (constant > std::numeric_limits<T>::max()) {
+        return CompareOutOfRange(vec.size(), op, true);
+    }
+    if (constant < std::numeric_limits<T>::min()) {
+        return CompareOutOfRange(vec.size(), op, false);
+    }
+
+    T value = static_cast<T>(constant);
+    return CompareIntegers<T, 0>(vec.data(), &value, vec.size(), op, isa);
+}
+
+// Word-level comparison of bool columns, false < true
+Bitmap CompareBitmaps(const Bitmap& lhs, ECompareOp op, const Bitmap& rhs) {
+    auto a = lhs.GetWords();
+    auto b = rhs.GetWords();
+    std::vector<uint64_t> words(a.size());
+
+    for (size_t i = 0; i < words.size(); ++i) {
+        switch (op) {
+            case ECompareOp::Equal:
+                words[i] = ~(a[i] ^ b[i]);
+                break;
+            case ECompareOp::NotEqual:
+                words[i] = a[i] ^ b[i];
+                break;
+            case ECompareOp::Less:
+                words[i] = ~a[i] & b[i];
+                break;
+            case ECompareOp::LessOrEqual:
+                words[i] = ~a[i] | b[i];
+                break;
+            case ECompareOp::Greater:
+                words[i] = a[i] & ~b[i];
+                break;
+            case ECompareOp::GreaterOrEqual:
+                words[i] = a[i] | ~b[i];
+                break;
+        }
+    }
+    return Bitmap(std::move(words), lhs.size());
+}
+
+bool CompareValues(std::string_view lhs, ECompareOp op, std::string_view rhs) {
+    switch (op) {
+        case ECompareOp::Equal:
+            return lhs == rhs;
+        case ECompareOp::NotEqual:
+            return lhs != rhs;
+        case ECompareOp::Less:
+            return lhs < rhs;
+        case ECompareOp::LessOrEqual:
+            return lhs <= rhs;
+        case ECompareOp::Greater:
+            return lhs > rhs;
+        case ECompareOp::GreaterOrEqual:
+            return lhs >= rhs;
+    }
+    return false;
+}
+
+std::vector<int64_t> WidenIntegers(const Column& column) {
+    return std::visit(
+        Types::overloaded{
+            [](const Bitmap&) -> std::vector<int64_t> {
+                throw std::logic_error("BOOL column is not an integer column");
+            },
+            [](const StringVector&) -> std::vector<int64_t> {
+                throw std::logic_error(
+                    "STRING column is not an integer column");
+            },
+            [](const auto& vec) {
+                return std::vector<int64_t>(vec.begin(), vec.end());
+            }},
+        column.GetData());
+}
+
+// DATE and TIMESTAMP share the storage of integers but not their units, so
+// only these are compared across widths
+bool IsPlainInteger(Types::DataType type) {
+    return type == Types::DataType::INT16 || type == Types::DataType::INT32 ||
+           type == Types::DataType::INT64;
+}
+
+void ApplyValidity(Bitmap& result, const Column& column) {
+    if (const Bitmap* validity = column.GetValidity()) {
+        result &= *validity;
+    }
+}
+
+void CheckIsa(FilterIsa isa) {
+    if (static_cast<uint8_t>(isa) > static_cast<uint8_t>(GetFilterIsa())) {
+        throw std::invalid_argument("Filter ISA is not supported by the CPU");
+    }
+}
+
+[[noreturn]] void ThrowTypeMismatch(const Column& column,
+                                    const std::string& what) {
+    throw std::invalid_argument("Cannot compare " +
+                                Types::GetTypeName(column.GetType()) +
+                                " column " + column.GetName() + " with " +
+                                what);
+}
+
+}  // namespace
+
+FilterIsa GetFilterIsa() {
+#ifdef COLUMNAR_FILTER_X86
+    static const FilterIsa isa = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") &&
+            __builtin_cpu_supports("avx512bw")) {
+            return FilterIsa::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return FilterIsa::AVX2;
+        }
+        return FilterIsa::SCALAR;
+    }();
+    return isa;
+#else
+    return FilterIsa::SCALAR;
+#endif
+}
+
+Bitmap CompareConstant(const Column& column, ECompareOp op,
+                       const TStatistics::TMinMax& constant) {
+    return CompareConstant(column, op, constant, GetFilterIsa());
+}
+
+Bitmap CompareConstant(const Column& column, ECompareOp op,
+                       const TStatistics::TMinMax& constant, FilterIsa isa) {
+    CheckIsa(isa);
+
+    Bitmap result = std::visit(
+        Types::overloaded{
+            [&](const Bitmap& vec) {
+                const bool* value = std::get_if<bool>(&constant);
+                if (!value) {
+                    ThrowTypeMismatch(column, "a non-bool constant");
+                }
+                return CompareBitmaps(vec, op, Bitmap(vec.size(), *value));
+            },
+            [&](const StringVector& vec) {
+                const auto* value = std::get_if<std::string>(&constant);
+                if (!value) {
+                    ThrowTypeMismatch(column, "a non-string constant");
+                }
+
+                Bitmap matches(vec.size());
+                for (size_t i = 0; i < vec.size(); ++i) {
+                    if (CompareValues(vec[i], op, *value)) {
+                        matches.Set(i, true);
+                    }
+                }
+                return matches;
+            },
+            [&](const auto& vec) {
+                std::optional<int64_t> value = std::visit(
+                    Types::overloaded{
+                        [](int16_t v) -> std::optional<int64_t> { return v; },
+                        [](int32_t v) -> std::optional<int64_t> { return v; },
+                        [](int64_t v) -> std::optional<int64_t> { return v; },
+                        [](const auto&) -> std::optional<int64_t> {
+                            return std::nullopt;
+                        }},
+                    constant);
+                if (!value) {
+                    ThrowTypeMismatch(column, "a non-integer constant");
+                }
+                return CompareIntegerConstant(vec, op, *value, isa);
+            }},
+        column.GetData());
+
+    ApplyValidity(result, column);
+    return result;
+}
+
+Bitmap CompareColumns(const Column& lhs, ECompareOp op, const Column& rhs) {
+    return CompareColumns(lhs, op, rhs, GetFilterIsa());
+}
+
+Bitmap CompareColumns(const Column& lhs, ECompareOp op, const Column& rhs,
+                      FilterIsa isa) {
+    CheckIsa(isa);
+
+    if (lhs.GetRowCount() != rhs.GetRowCount()) {
+        throw std::invalid_argument("Row count mismatch: " + lhs.GetName() +
+                                    " has " +
+                                    std::to_string(lhs.GetRowCount()) + ", " +
+                                    rhs.GetName() + " has " +
+                                    std::to_string(rhs.GetRowCount()));
+    }
+
+    const auto& lhsData = lhs.GetData();
+    const auto& rhsData = rhs.GetData();
+
+    Bitmap result;
+    if (lhs.GetType() == rhs.GetType()) {
+        result = std::visit(
+            Types::overloaded{
+                [&](const Bitmap& vec) {
+                    return CompareBitmaps(vec, op, std::get<Bitmap>(rhsData));
+                },
+                [&](const StringVector& vec) {
+                    const auto& other = std::get<StringVector>(rhsData);
+                    Bitmap matches(vec.size());
+                    for (size_t i = 0; i < vec.size(); ++i) {
+                        if (CompareValues(vec[i], op, other[i])) {
+                            matches.Set(i, true);
+                        }
+                    }
+                    return matches;
+                },
+                [&](const auto& vec) {
+                    using TVector = std::remove_cvref_t<decltype(vec)>;
+                    const auto& other = std::get<TVector>(rhsData);
+                    return CompareIntegers<typename TVector::value_type, 1>(
+                        vec.data(), other.data(), vec.size(), op, isa);
+                }},
+            lhsData);
+    } else if (IsPlainInteger(lhs.GetType()) &&
+               IsPlainInteger(rhs.GetType())) {
+        std::vector<int64_t> a = WidenIntegers(lhs);
+        std::vector<int64_t> b = WidenIntegers(rhs);
+        result = CompareIntegers<int64_t, 1>(a.data(), b.data(), a.size(), op,
+                                             isa);
+    } else {
+        ThrowTypeMismatch(lhs, Types::GetTypeName(rhs.GetType()) +
+                                   " column " + rhs.GetName());
+    }
+
+    ApplyValidity(result, lhs);
+    ApplyValidity(result, rhs);
+    return result;
+}
+
+void FilterBatch(Batch& batch, size_t columnIndex, ECompareOp op,
+                 const TStatistics::TMinMax& constant) {
+    Bitmap mask = CompareConstant(batch.GetColumn(columnIndex), op, constant);
+
+    if (batch.HasSelection()) {
+        mask &= batch.GetSelectionMask();
+    }
+    batch.SetSelectionMask(mask);
+}
+
+}  // namespace Columnar::Compute
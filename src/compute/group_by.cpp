@@ -0,0 +1,674 @@
+#include <compute/group_by.h>
+
+#include <charconv>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace Columnar::Compute {
+
+namespace {
+
+// Serialized NULL key value, non-NULL values start with 1
+constexpr char kNullMarker = 0;
+constexpr char kValueMarker = 1;
+
+bool IsIntegerBased(Types::DataType type) {
+    switch (type) {
+        case Types::DataType::INT16:
+        case Types::DataType::INT32:
+        case Types::DataType::INT64:
+        case Types::DataType::DATE:
+        case Types::DataType::TIMESTAMP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::string GetFunctionName(AggregateFunction function) {
+    switch (function) {
+        case AggregateFunction::COUNT:
+            return "count";
+        case AggregateFunction::SUM:
+            return "sum";
+        case AggregateFunction::MIN:
+            return "min";
+        case AggregateFunction::MAX:
+            return "max";
+        case AggregateFunction::AVG:
+            return "avg";
+    }
+    throw std::invalid_argument("Unknown aggregate function");
+}
+
+// murmur3 finalizer, spreads sequential keys over the table
+uint64_t HashInteger(int64_t key) {
+    uint64_t x = static_cast<uint64_t>(key);
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    return x ^ (x >> 33);
+}
+
+uint64_t HashBytes(std::string_view key) {
+    return std::hash<std::string_view>{}(key);
+}
+
+const Column& FindInput(const Batch& batch, const ColumnSchema& schema) {
+    const Column* column = batch.FindColumn(schema.name);
+    if (!column) {
+        throw std::invalid_argument("Batch has no column " + schema.name);
+    }
+    if (column->GetType() != schema.type) {
+        throw std::invalid_argument(
+            "Column " + schema.name + " is " +
+            Types::GetTypeName(column->GetType()) + ", expected " +
+            Types::GetTypeName(schema.type));
+    }
+    return *column;
+}
+
+// Calls `update(group, value)` for every selected non-NULL row
+template <typename TVector, typename F>
+void ForEachValue(const TVector& vec, const Bitmap* validity,
+                  const std::vector<uint32_t>* rows,
+                  const std::vector<uint32_t>& groups, F update) {
+    for (size_t k = 0; k < groups.size(); ++k) {
+        size_t row = rows ? (*rows)[k] : k;
+        if (validity && !(*validity)[row]) {
+            continue;
+        }
+        update(groups[k], vec[row]);
+    }
+}
+
+void AppendSerialized(std::string& out, std::string_view value) {
+    auto length = static_cast<uint32_t>(value.size());
+    out.assign(1, kValueMarker);
+    out.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    out.append(value);
+}
+
+}  // namespace
+
+HashGroupBy::HashGroupBy(const Schema& schema, std::vector<std::string> keys,
+                         std::vector<AggregateSpec> aggregates) {
+    if (keys.empty()) {
+        throw std::invalid_argument("GROUP BY needs at least one key column");
+    }
+
+    for (const auto& name : keys) {
+        auto index = schema.FindColumn(name);
+        if (!index) {
+            throw std::invalid_argument("Unknown key column: " + name);
+        }
+        keys_.push_back(schema.GetColumn(*index));
+    }
+
+    for (auto& spec : aggregates) {
+        AggregateState state;
+        std::string functionName = GetFunctionName(spec.function);
+
+        if (spec.column.empty()) {
+            if (spec.function != AggregateFunction::COUNT) {
+                throw std::invalid_argument(functionName +
+                                            " needs an input column");
+            }
+        } else {
+            auto index = schema.FindColumn(spec.column);
+            if (!index) {
+                throw std::invalid_argument("Unknown aggregate column: " +
+                                            spec.column);
+            }
+            state.inputType = schema.GetColumn(*index).type;
+            if (spec.function != AggregateFunction::COUNT &&
+                !IsIntegerBased(state.inputType)) {
+                throw std::invalid_argument(
+                    "Cannot compute " + functionName + " of " +
+                    Types::GetTypeName(state.inputType) + " column " +
+                    spec.column);
+            }
+        }
+
+        if (spec.name.empty()) {
+            spec.name = functionName + "(" +
+                        (spec.column.empty() ? "*" : spec.column) + ")";
+        }
+        state.spec = std::move(spec);
+        aggregates_.push_back(std::move(state));
+    }
+
+    integerKey_ = keys_.size() == 1 && IsIntegerBased(keys_[0].type);
+    if (integerKey_) {
+        integerSlots_.assign(kInitialSlotCount, {0, kEmptyGroup});
+    } else {
+        slots_.assign(kInitialSlotCount, {0, kEmptyGroup});
+    }
+}
+
+void HashGroupBy::Consume(const Batch& batch) {
+    const std::vector<uint32_t>* rows = batch.GetSelection();
+    if (integerKey_) {
+        MapIntegerKeys(batch, rows);
+    } else {
+        MapSerializedKeys(batch, rows);
+    }
+    UpdateAggregates(batch, rows);
+}
+
+void HashGroupBy::Consume(const Batch& batch, const DictionaryColumn& keys) {
+    if (keys_.size() != 1 || keys_[0].type != Types::DataType::STRING) {
+        throw std::invalid_argument(
+            "Dictionary keys need a single STRING key column");
+    }
+    if (keys.GetRowCount() != batch.GetRowCount()) {
+        throw std::invalid_argument("Dictionary key row count mismatch: " +
+                                    std::to_string(keys.GetRowCount()) +
+                                    " codes for " +
+                                    std::to_string(batch.GetRowCount()) +
+                                    " rows");
+    }
+
+    const std::vector<uint32_t>* rows = batch.GetSelection();
+    size_t count = batch.GetSelectedRowCount();
+    groups_.resize(count);
+
+    // every code is hashed at most once per batch
+    std::vector<uint32_t> codeGroups(keys.dictionary.size(), kEmptyGroup);
+    std::string key;
+    for (size_t k = 0; k < count; ++k) {
+        size_t row = rows ? (*rows)[k] : k;
+        if (keys.validity && !(*keys.validity)[row]) {
+            std::string_view nullKey(&kNullMarker, 1);
+            groups_[k] = FindSerializedGroup(nullKey, HashBytes(nullKey));
+            continue;
+        }
+
+        uint32_t code = keys.codes[row];
+        if (code >= codeGroups.size()) {
+            throw std::out_of_range("Dictionary code out of range: " +
+                                    std::to_string(code));
+        }
+        if (codeGroups[code] == kEmptyGroup) {
+            AppendSerialized(key, keys.dictionary[code]);
+            codeGroups[code] = FindSerializedGroup(key, HashBytes(key));
+        }
+        groups_[k] = codeGroups[code];
+    }
+
+    UpdateAggregates(batch, rows);
+}
+
+size_t HashGroupBy::GetGroupCount() const {
+    return groupCount_;
+}
+
+uint32_t HashGroupBy::FindIntegerGroup(int64_t key) {
+    if ((groupCount_ + 1) * 2 > integerSlots_.size()) {
+        Grow();
+    }
+
+    size_t mask = integerSlots_.size() - 1;
+    for (size_t pos = HashInteger(key) & mask;; pos = (pos + 1) & mask) {
+        IntegerSlot& slot = integerSlots_[pos];
+        if (slot.group == kEmptyGroup) {
+            slot.key = key;
+            slot.group = AddGroup();
+            integerKeys_.push_back(key);
+            return slot.group;
+        }
+        if (slot.key == key) {
+            return slot.group;
+        }
+    }
+}
+
+uint32_t HashGroupBy::FindSerializedGroup(std::string_view key,
+                                          uint64_t hash) {
+    if ((groupCount_ + 1) * 2 > slots_.size()) {
+        Grow();
+    }
+
+    auto tag = static_cast<uint32_t>(hash >> 32);
+    GermanString probe = GermanString::Make(key, key.data());
+    size_t mask = slots_.size() - 1;
+    for (size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+        Slot& slot = slots_[pos];
+        if (slot.group == kEmptyGroup) {
+            slot.tag = tag;
+            slot.group = AddGroup();
+            serializedKeys_.push_back(key);
+            hashes_.push_back(hash);
+            return slot.group;
+        }
+        if (slot.tag == tag && serializedKeys_[slot.group] == probe) {
+            return slot.group;
+        }
+    }
+}
+
+uint32_t HashGroupBy::AddGroup() {
+    if (groupCount_ >= kEmptyGroup) {
+        throw std::length_error("Too many groups");
+    }
+
+    for (auto& state : aggregates_) {
+        state.counts.push_back(0);
+        switch (state.spec.function) {
+            case AggregateFunction::SUM:
+            case AggregateFunction::AVG:
+                state.sums.push_back(0);
+                break;
+            case AggregateFunction::MIN:
+            case AggregateFunction::MAX:
+                state.values.push_back(0);
+                break;
+            case AggregateFunction::COUNT:
+                break;
+        }
+    }
+    return static_cast<uint32_t>(groupCount_++);
+}
+
+void HashGroupBy::Grow() {
+    if (integerKey_) {
+        std::vector<IntegerSlot> slots(integerSlots_.size() * 2,
+                                       {0, kEmptyGroup});
+        size_t mask = slots.size() - 1;
+        for (uint32_t group = 0; group < groupCount_; ++group) {
+            if (group == nullGroup_) {
+                continue;
+            }
+            int64_t key = integerKeys_[group];
+            size_t pos = HashInteger(key) & mask;
+            while (slots[pos].group != kEmptyGroup) {
+                pos = (pos + 1) & mask;
+            }
+            slots[pos] = {key, group};
+        }
+        integerSlots_ = std::move(slots);
+        return;
+    }
+
+    std::vector<Slot> slots(slots_.size() * 2, {0, kEmptyGroup});
+    size_t mask = slots.size() - 1;
+    for (uint32_t group = 0; group < groupCount_; ++group) {
+        uint64_t hash = hashes_[group];
+        size_t pos = hash & mask;
+        while (slots[pos].group != kEmptyGroup) {
+            pos = (pos + 1) & mask;
+        }
+        slots[pos] = {static_cast<uint32_t>(hash >> 32), group};
+    }
+    slots_ = std::move(slots);
+}
+
+void HashGroupBy::MapIntegerKeys(const Batch& batch,
+                                 const std::vector<uint32_t>* rows) {
+    const Column& column = FindInput(batch, keys_[0]);
+    const Bitmap* validity = column.GetValidity();
+    size_t count = batch.GetSelectedRowCount();
+    groups_.resize(count);
+
+    std::visit(
+        Types::overloaded{
+            [](const Bitmap&) {
+                throw std::logic_error("BOOL key is not an integer key");
+            },
+            [](const StringVector&) {
+                throw std::logic_error("STRING key is not an integer key");
+            },
+            [&](const auto& vec) {
+                for (size_t k = 0; k < count; ++k) {
+                    size_t row = rows ? (*rows)[k] : k;
+                    if (validity && !(*validity)[row]) {
+                        if (!nullGroup_) {
+                            nullGroup_ = AddGroup();
+                            integerKeys_.push_back(0);
+                        }
+                        groups_[k] = *nullGroup_;
+                        continue;
+                    }
+                    groups_[k] = FindIntegerGroup(vec[row]);
+                }
+            }},
+        column.GetData());
+}
+
+// Every key column appends a marker byte and, for non-NULL rows, the value
+// to each row's key: fixed-width values raw, strings with a u32 length
+void HashGroupBy::MapSerializedKeys(const Batch& batch,
+                                    const std::vector<uint32_t>* rows) {
+    size_t count = batch.GetSelectedRowCount();
+    groups_.resize(count);
+    offsets_.assign(count + 1, 0);
+
+    std::vector<const Column*> columns;
+    for (const auto& key : keys_) {
+        columns.push_back(&FindInput(batch, key));
+    }
+
+    // key sizes, then offsets
+    for (const Column* column : columns) {
+        const Bitmap* validity = column->GetValidity();
+        std::visit(
+            Types::overloaded{
+                [&](const StringVector& vec) {
+                    for (size_t k = 0; k < count; ++k) {
+                        size_t row = rows ? (*rows)[k] : k;
+                        bool valid = !validity || (*validity)[row];
+                        offsets_[k + 1] +=
+                            valid ? 1 + sizeof(uint32_t) + vec[row].size() : 1;
+                    }
+                },
+                [&](const auto& vec) {
+                    // Bitmap::operator[] returns bool, BOOL takes one byte
+                    constexpr size_t kSize = sizeof(vec[0]);
+                    for (size_t k = 0; k < count; ++k) {
+                        size_t row = rows ? (*rows)[k] : k;
+                        bool valid = !validity || (*validity)[row];
+                        offsets_[k + 1] += valid ? 1 + kSize : 1;
+                    }
+                }},
+            column->GetData());
+    }
+    for (size_t k = 0; k < count; ++k) {
+        offsets_[k + 1] += offsets_[k];
+    }
+    if (offsets_[count] > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("GROUP BY keys of a batch exceed 4 GiB");
+    }
+    buffer_.resize(offsets_[count]);
+
+    // values, column by column
+    std::vector<size_t> cursors(offsets_.begin(), offsets_.end() - 1);
+    for (const Column* column : columns) {
+        const Bitmap* validity = column->GetValidity();
+        std::visit(
+            Types::overloaded{
+                [&](const Bitmap& vec) {
+                    for (size_t k = 0; k < count; ++k) {
+                        size_t row = rows ? (*rows)[k] : k;
+                        char* out = buffer_.data() + cursors[k];
+                        if (validity && !(*validity)[row]) {
+                            *out = kNullMarker;
+                            cursors[k] += 1;
+                            continue;
+                        }
+                        out[0] = kValueMarker;
+                        out[1] = vec[row] ? 1 : 0;
+                        cursors[k] += 2;
+                    }
+                },
+                [&](const StringVector& vec) {
+                    for (size_t k = 0; k < count; ++k) {
+                        size_t row = rows ? (*rows)[k] : k;
+                        char* out = buffer_.data() + cursors[k];
+                        if (validity && !(*validity)[row]) {
+                            *out = kNullMarker;
+                            cursors[k] += 1;
+                            continue;
+                        }
+                        std::string_view value = vec[row];
+                        auto length = static_cast<uint32_t>(value.size());
+                        out[0] = kValueMarker;
+                        std::memcpy(out + 1, &length, sizeof(length));
+                        std::memcpy(out + 1 + sizeof(length), value.data(),
+                                    value.size());
+                        cursors[k] += 1 + sizeof(length) + length;
+                    }
+                },
+                [&](const auto& vec) {
+                    for (size_t k = 0; k < count; ++k) {
+                        size_t row = rows ? (*rows)[k] : k;
+                        char* out = buffer_.data() + cursors[k];
+                        if (validity && !(*validity)[row]) {
+                            *out = kNullMarker;
+                            cursors[k] += 1;
+                            continue;
+                        }
+                        out[0] = kValueMarker;
+                        std::memcpy(out + 1, &vec[row], sizeof(vec[row]));
+                        cursors[k] += 1 + sizeof(vec[row]);
+                    }
+                }},
+            column->GetData());
+    }
+
+    for (size_t k = 0; k < count; ++k) {
+        std::string_view key(buffer_.data() + offsets_[k],
+                             offsets_[k + 1] - offsets_[k]);
+        groups_[k] = FindSerializedGroup(key, HashBytes(key));
+    }
+}
+
+void HashGroupBy::UpdateAggregates(const Batch& batch,
+                                   const std::vector<uint32_t>* rows) {
+    for (auto& state : aggregates_) {
+        auto& counts = state.counts;
+        if (state.spec.column.empty()) {
+            for (uint32_t group : groups_) {
+                ++counts[group];
+            }
+            continue;
+        }
+
+        const Column& column =
+            FindInput(batch, {state.spec.column, state.inputType});
+        const Bitmap* validity = column.GetValidity();
+        auto& sums = state.sums;
+        auto& values = state.values;
+
+        // one pass over the column per aggregate, the function is fixed
+        // outside the row loop
+        auto update = [&](const auto& vec) {
+            switch (state.spec.function) {
+                case AggregateFunction::COUNT:
+                    ForEachValue(vec, validity, rows, groups_,
+                                 [&](uint32_t group, auto) {
+                                     ++counts[group];
+                                 });
+                    break;
+                case AggregateFunction::SUM:
+                case AggregateFunction::AVG:
+                    ForEachValue(vec, validity, rows, groups_,
+                                 [&](uint32_t group, int64_t value) {
+                                     ++counts[group];
+                                     sums[group] += value;
+                                 });
+                    break;
+                case AggregateFunction::MIN:
+                    ForEachValue(vec, validity, rows, groups_,
+                                 [&](uint32_t group, int64_t value) {
+                                     if (counts[group]++ == 0 ||
+                                         value < values[group]) {
+                                         values[group] = value;
+                                     }
+                                 });
+                    break;
+                case AggregateFunction::MAX:
+                    ForEachValue(vec, validity, rows, groups_,
+                                 [&](uint32_t group, int64_t value) {
+                                     if (counts[group]++ == 0 ||
+                                         value > values[group]) {
+                                         values[group] = value;
+                                     }
+                                 });
+                    break;
+            }
+        };
+
+        std::visit(Types::overloaded{
+                       [&](const Bitmap& vec) {
+                           ForEachValue(vec, validity, rows, groups_,
+                                        [&](uint32_t group, bool) {
+                                            ++counts[group];
+                                        });
+                       },
+                       [&](const StringVector& vec) {
+                           ForEachValue(vec, validity, rows, groups_,
+                                        [&](uint32_t group, std::string_view) {
+                                            ++counts[group];
+                                        });
+                       },
+                       update},
+                   column.GetData());
+    }
+}
+
+std::vector<Column> HashGroupBy::DecodeKeys() const {
+    std::vector<Column> columns;
+
+    if (integerKey_) {
+        Column column(keys_[0].name, keys_[0].type,
+                      Types::CreateEmptyColumnData(keys_[0].type));
+        std::visit(
+            [&](auto& vec) {
+                using TVector = std::remove_cvref_t<decltype(vec)>;
+                if constexpr (!std::is_same_v<TVector, Bitmap> &&
+                              !std::is_same_v<TVector, StringVector>) {
+                    for (int64_t key : integerKeys_) {
+                        vec.push_back(
+                            static_cast<typename TVector::value_type>(key));
+                    }
+                }
+            },
+            column.GetMutableData());
+
+        if (nullGroup_) {
+            column.SetNull(*nullGroup_);
+        }
+        columns.push_back(std::move(column));
+        return columns;
+    }
+
+    // column by column, with a read position per group
+    std::vector<size_t> cursors(groupCount_, 0);
+    for (const auto& key : keys_) {
+        Column column(key.name, key.type,
+                      Types::CreateEmptyColumnData(key.type));
+        Bitmap validity(groupCount_, true);
+
+        std::visit(
+            [&](auto& vec) {
+                using TVector = std::remove_cvref_t<decltype(vec)>;
+                for (size_t group = 0; group < groupCount_; ++group) {
+                    std::string_view serialized =
+                        serializedKeys_[group].view();
+                    const char* in = serialized.data() + cursors[group];
+
+                    if (*in == kNullMarker) {
+                        validity.Set(group, false);
+                        vec.push_back({});
+                        cursors[group] += 1;
+                    } else if constexpr (std::is_same_v<TVector, Bitmap>) {
+                        vec.push_back(in[1] != 0);
+                        cursors[group] += 2;
+                    } else if constexpr (std::is_same_v<TVector,
+                                                        StringVector>) {
+                        uint32_t length;
+                        std::memcpy(&length, in + 1, sizeof(length));
+                        vec.push_back(std::string_view(
+                            in + 1 + sizeof(length), length));
+                        cursors[group] += 1 + sizeof(length) + length;
+                    } else {
+                        typename TVector::value_type value;
+                        std::memcpy(&value, in + 1, sizeof(value));
+                        vec.push_back(value);
+                        cursors[group] += 1 + sizeof(value);
+                    }
+                }
+            },
+            column.GetMutableData());
+
+        column.SetValidity(std::move(validity));
+        columns.push_back(std::move(column));
+    }
+    return columns;
+}
+
+Batch HashGroupBy::GetResult() const {
+    std::vector<Column> columns = DecodeKeys();
+
+    for (const auto& state : aggregates_) {
+        const std::string& name = state.spec.name;
+        Bitmap validity(groupCount_, true);
+        for (size_t group = 0; group < groupCount_; ++group) {
+            if (state.counts[group] == 0) {
+                validity.Set(group, false);
+            }
+        }
+
+        switch (state.spec.function) {
+            case AggregateFunction::COUNT:
+                columns.push_back(Column::CreateInt64(name, state.counts));
+                continue;
+
+            case AggregateFunction::SUM: {
+                std::vector<int64_t> sums;
+                sums.reserve(groupCount_);
+                for (Int128 sum : state.sums) {
+                    if (sum > std::numeric_limits<int64_t>::max() ||
+                        sum < std::numeric_limits<int64_t>::min()) {
+                        throw std::overflow_error(name +
+                                                  " does not fit INT64");
+                    }
+                    sums.push_back(static_cast<int64_t>(sum));
+                }
+                columns.push_back(Column::CreateInt64(name, std::move(sums)));
+                break;
+            }
+
+            case AggregateFunction::MIN:
+            case AggregateFunction::MAX: {
+                Column column(name, state.inputType,
+                              Types::CreateEmptyColumnData(state.inputType));
+                std::visit(
+                    [&](auto& vec) {
+                        using TVector = std::remove_cvref_t<decltype(vec)>;
+                        if constexpr (!std::is_same_v<TVector, Bitmap> &&
+                                      !std::is_same_v<TVector, StringVector>) {
+                            using T = typename TVector::value_type;
+                            for (int64_t value : state.values) {
+                                vec.push_back(static_cast<T>(value));
+                            }
+                        }
+                    },
+                    column.GetMutableData());
+                columns.push_back(std::move(column));
+                break;
+            }
+
+            case AggregateFunction::AVG: {
+                StringVector text;
+                char buffer[32];
+                for (size_t group = 0; group < groupCount_; ++group) {
+                    if (state.counts[group] == 0) {
+                        text.push_back({});
+                        continue;
+                    }
+                    double average = static_cast<double>(state.sums[group]) /
+                                     static_cast<double>(state.counts[group]);
+                    char* end =
+                        std::to_chars(buffer, buffer + sizeof(buffer), average)
+                            .ptr;
+                    text.push_back(
+                        {buffer, static_cast<size_t>(end - buffer)});
+                }
+                columns.emplace_back(name, Types::DataType::STRING,
+                                     std::move(text));
+                break;
+            }
+        }
+        columns.back().SetValidity(std::move(validity));
+    }
+
+    return Batch(std::move(columns));
+}
+
+}  // namespace Columnar::Compute
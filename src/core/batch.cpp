@@ -89,7 +89,91 @@ Column* Batch::FindMutableColumn(const std::string& name) {
     return &columns_[*idx];
 }
 
+bool Batch::HasSelection() const {
+    return selection_.has_value();
+}
+
+const std::vector<uint32_t>* Batch::GetSelection() const {
+    return selection_ ? &*selection_ : nullptr;
+}
+
+size_t Batch::GetSelectedRowCount() const {
+    return selection_ ? selection_->size() : rowCount_;
+}
+
+Bitmap Batch::GetSelectionMask() const {
+    if (!selection_) {
+        return Bitmap(rowCount_, true);
+    }
+
+    Bitmap mask(rowCount_);
+    for (uint32_t row : *selection_) {
+        mask.Set(row, true);
+    }
+    return mask;
+}
+
+void Batch::SetSelection(std::vector<uint32_t> rows) {
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (rows[i] >= rowCount_) {
+            throw std::out_of_range("Selected row out of range: " +
+                                    std::to_string(rows[i]));
+        }
+        if (i > 0 && rows[i] <= rows[i - 1]) {
+            throw std::invalid_argument(
+                "Selected rows must be strictly ascending");
+        }
+    }
+    selection_ = std::move(rows);
+}
+
+void Batch::SetSelectionMask(const Bitmap& mask) {
+    if (mask.size() != rowCount_) {
+        throw std::invalid_argument("Selection mask size mismatch: " +
+                                    std::to_string(mask.size()) + " bits for " +
+                                    std::to_string(rowCount_) + " rows");
+    }
+    selection_ = mask.GetSetIndices();
+}
+
+void Batch::ClearSelection() {
+    selection_.reset();
+}
+
+void Batch::Compact() {
+    if (!selection_) {
+        return;
+    }
+
+    for (auto& col : columns_) {
+        col = col.Select(*selection_);
+    }
+    rowCount_ = selection_->size();
+    selection_.reset();
+}
+
+void Batch::CompactIfSparse(double selectivity) {
+    if (selection_ && selection_->size() < selectivity * rowCount_) {
+        Compact();
+    }
+}
+
+Batch Batch::GetCompacted() const {
+    std::vector<Column> columns;
+    columns.reserve(columns_.size());
+
+    for (const auto& col : columns_) {
+        columns.push_back(selection_ ? col.Select(*selection_) : col);
+    }
+    return Batch(schema_, std::move(columns));
+}
+
 bool Batch::AppendRow(std::vector<std::string>&& values) {
+    if (selection_) {
+        throw std::logic_error("Cannot append rows to a batch with a "
+                               "selection");
+    }
+
     if (rowCount_ >= kBatchSize) {
         return false;
     }
@@ -119,6 +203,7 @@ void Batch::Clear() {
         col.Clear();
     }
     rowCount_ = 0;
+    selection_.reset();
 }
 
 bool Batch::IsValid() const {
@@ -0,0 +1,64 @@
+#include <core/batch_view.h>
+
+#include <stdexcept>
+#include <string>
+
+namespace Columnar {
+
+BatchView::BatchView(Schema schema, std::vector<ColumnView> columns)
+    : schema_(std::move(schema)),
+      columns_(std::move(columns)) {
+    rowCount_ = columns_.empty() ? 0 : columns_[0].GetRowCount();
+
+    for (size_t i = 1; i < columns_.size(); ++i) {
+        if (columns_[i].GetRowCount() != rowCount_) {
+            throw std::invalid_argument(
+                "Column size mismatch: column 0 has " +
+                std::to_string(rowCount_) + " rows, column " +
+                std::to_string(i) + " has " +
+                std::to_string(columns_[i].GetRowCount()) + " rows");
+        }
+    }
+}
+
+size_t BatchView::GetColumnCount() const {
+    return columns_.size();
+}
+
+size_t BatchView::GetRowCount() const {
+    return rowCount_;
+}
+
+const Schema& BatchView::GetSchema() const {
+    return schema_;
+}
+
+const ColumnView& BatchView::GetColumn(size_t index) const {
+    if (index >= columns_.size()) {
+        throw std::out_of_range("Column index out of range: " +
+                                std::to_string(index));
+    }
+    return columns_[index];
+}
+
+const ColumnView* BatchView::FindColumn(const std::string& name) const {
+    auto idx = schema_.FindColumn(name);
+    if (!idx) {
+        return nullptr;
+    }
+
+    return &columns_[*idx];
+}
+
+Batch BatchView::Materialize() const {
+    std::vector<Column> columns;
+    columns.reserve(columns_.size());
+
+    for (const auto& view : columns_) {
+        columns.push_back(view.Materialize());
+    }
+
+    return Batch(schema_, std::move(columns));
+}
+
+}  // namespace Columnar
@@ -0,0 +1,110 @@
+#include <core/bitmap.h>
+
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+namespace Columnar {
+
+Bitmap::Bitmap(size_t size, bool value)
+    : words_(GetWordCount(size), value ? ~uint64_t{0} : 0),
+      size_(size) {
+    ClearTail();
+}
+
+Bitmap::Bitmap(std::initializer_list<bool> values) {
+    reserve(values.size());
+    for (bool value : values) {
+        push_back(value);
+    }
+}
+
+Bitmap::Bitmap(const std::vector<bool>& values)
+    : words_(GetWordCount(values.size())),
+      size_(values.size()) {
+    for (size_t i = 0; i < size_; ++i) {
+        words_[i / kWordBits] |= uint64_t{values[i]} << (i % kWordBits);
+    }
+}
+
+Bitmap::Bitmap(std::vector<uint64_t> words, size_t size)
+    : words_(std::move(words)),
+      size_(size) {
+    if (words_.size() != GetWordCount(size_)) {
+        throw std::invalid_argument("Bitmap word count does not match size");
+    }
+    ClearTail();
+}
+
+size_t Bitmap::CountSet() const {
+    size_t count = 0;
+    for (uint64_t word : words_) {
+        count += std::popcount(word);
+    }
+    return count;
+}
+
+std::vector<uint32_t> Bitmap::GetSetIndices() const {
+    std::vector<uint32_t> indices;
+    indices.reserve(CountSet());
+
+    for (size_t i = 0; i < words_.size(); ++i) {
+        for (uint64_t word = words_[i]; word != 0; word &= word - 1) {
+            indices.push_back(
+                static_cast<uint32_t>(i * kWordBits + std::countr_zero(word)));
+        }
+    }
+    return indices;
+}
+
+void Bitmap::resize(size_t size, bool value) {
+    size_t oldSize = size_;
+    words_.resize(GetWordCount(size), value ? ~uint64_t{0} : 0);
+    size_ = size;
+
+    if (value && size > oldSize && oldSize % kWordBits != 0) {
+        words_[oldSize / kWordBits] |= ~uint64_t{0} << (oldSize % kWordBits);
+    }
+    ClearTail();
+}
+
+void Bitmap::reserve(size_t capacity) {
+    words_.reserve(GetWordCount(capacity));
+}
+
+void Bitmap::clear() {
+    words_.clear();
+    size_ = 0;
+}
+
+Bitmap& Bitmap::operator&=(const Bitmap& other) {
+    CheckSameSize(other);
+    for (size_t i = 0; i < words_.size(); ++i) {
+        words_[i] &= other.words_[i];
+    }
+    return *this;
+}
+
+Bitmap& Bitmap::operator|=(const Bitmap& other) {
+    CheckSameSize(other);
+    for (size_t i = 0; i < words_.size(); ++i) {
+        words_[i] |= other.words_[i];
+    }
+    return *this;
+}
+
+void Bitmap::CheckSameSize(const Bitmap& other) const {
+    if (size_ != other.size_) {
+        throw std::invalid_argument("Bitmap size mismatch: " +
+                                    std::to_string(size_) + " vs " +
+                                    std::to_string(other.size_));
+    }
+}
+
+void Bitmap::ClearTail() {
+    if (size_ % kWordBits != 0) {
+        words_.back() &= (uint64_t{1} << (size_ % kWordBits)) - 1;
+    }
+}
+
+}  // namespace Columnar
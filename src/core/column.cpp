@@ -3,6 +3,7 @@
 #include <parser/value_parser.h>
 
 #include <stdexcept>
+#include <type_traits>
 #include <variant>
 
 namespace Columnar {
@@ -30,12 +31,21 @@ Column Column::CreateInt64(const std::string& name, std::vector<int64_t> data) {
     return Column(name, Types::DataType::INT64, std::move(data));
 }
 
-Column Column::CreateBool(const std::string& name, std::vector<bool> data) {
+Column Column::CreateBool(const std::string& name,
+                          const std::vector<bool>& data) {
+    return Column(name, Types::DataType::BOOL, Bitmap(data));
+}
+
+Column Column::CreateBool(const std::string& name, Bitmap data) {
     return Column(name, Types::DataType::BOOL, std::move(data));
 }
 
 Column Column::CreateString(const std::string& name,
                             std::vector<std::string> data) {
+    return Column(name, Types::DataType::STRING, StringVector(data));
+}
+
+Column Column::CreateString(const std::string& name, StringVector data) {
     return Column(name, Types::DataType::STRING, std::move(data));
 }
 
@@ -69,25 +79,104 @@ std::string Column::GetValueAsString(size_t row) const {
                                 std::to_string(row));
     }
 
+    if (IsNull(row)) {
+        return {};
+    }
+
     return std::visit(
         Types::overloaded{
             [row](const std::vector<int16_t>& vec) {
                 return std::to_string(vec[row]);
             },
-            [row](const std::vector<int32_t>& vec) {
+            [this, row](const std::vector<int32_t>& vec) {
+                if (type_ == Types::DataType::DATE) {
+                    return Parser::FormatDate(vec[row]);
+                }
                 return std::to_string(vec[row]);
             },
-            [row](const std::vector<int64_t>& vec) {
+            [this, row](const std::vector<int64_t>& vec) {
+                if (type_ == Types::DataType::TIMESTAMP) {
+                    return Parser::FormatTimestamp(vec[row]);
+                }
                 return std::to_string(vec[row]);
             },
-            [row](const std::vector<bool>& vec) {
+            [row](const Bitmap& vec) {
                 return vec[row] ? std::string{"true"} : std::string{"false"};
             },
-            [row](const std::vector<std::string>& vec) { return vec[row]; }},
+            [row](const StringVector& vec) { return std::string(vec[row]); }},
         data_);
 }
 
+const Bitmap* Column::GetValidity() const {
+    return validity_ ? &*validity_ : nullptr;
+}
+
+bool Column::IsNull(size_t row) const {
+    return validity_ && !(*validity_)[row];
+}
+
+size_t Column::GetNullCount() const {
+    return validity_ ? validity_->size() - validity_->CountSet() : 0;
+}
+
+Column Column::Select(std::span<const uint32_t> rows) const {
+    for (uint32_t row : rows) {
+        if (row >= GetRowCount()) {
+            throw std::out_of_range("Row index out of range: " +
+                                    std::to_string(row));
+        }
+    }
+
+    auto data = std::visit(
+        Types::overloaded{
+            [rows](const StringVector& vec) -> Types::AnyColumnData {
+                size_t totalLength = 0;
+                for (uint32_t row : rows) {
+                    totalLength += vec[row].size();
+                }
+
+                StringVector result;
+                result.reserve(rows.size(), totalLength);
+                for (uint32_t row : rows) {
+                    result.push_back(vec[row]);
+                }
+                return result;
+            },
+            [rows](const Bitmap& vec) -> Types::AnyColumnData {
+                Bitmap result;
+                result.reserve(rows.size());
+                for (uint32_t row : rows) {
+                    result.push_back(vec[row]);
+                }
+                return result;
+            },
+            [rows](const auto& vec) -> Types::AnyColumnData {
+                std::remove_cvref_t<decltype(vec)> result(rows.size());
+                for (size_t i = 0; i < rows.size(); ++i) {
+                    result[i] = vec[rows[i]];
+                }
+                return result;
+            }},
+        data_);
+
+    Column column(name_, type_, std::move(data));
+    if (validity_) {
+        Bitmap validity;
+        validity.reserve(rows.size());
+        for (uint32_t row : rows) {
+            validity.push_back((*validity_)[row]);
+        }
+        column.SetValidity(std::move(validity));
+    }
+    return column;
+}
+
 void Column::AppendFromString(std::string&& value) {
+    if (value.empty() && type_ != Types::DataType::STRING) {
+        AppendNull();
+        return;
+    }
+
     auto parsed = Parser::ParseValue(std::move(value), type_);
 
     std::visit(Types::overloaded{
@@ -100,14 +189,54 @@ void Column::AppendFromString(std::string&& value) {
                    [&parsed](std::vector<int64_t>& v) {
                        v.push_back(std::get<int64_t>(parsed));
                    },
-                   [&parsed](std::vector<bool>& v) {
+                   [&parsed](Bitmap& v) {
                        v.push_back(std::get<bool>(parsed));
                    },
-                   [&parsed](std::vector<std::string>& v) {
+                   [&parsed](StringVector& v) {
                        v.push_back(std::get<std::string>(parsed));
                    },
                },
                data_);
+
+    if (validity_) {
+        validity_->push_back(true);
+    }
+}
+
+void Column::AppendNull() {
+    std::visit([](auto& vec) { vec.push_back({}); }, data_);
+    GetMutableValidity().Set(GetRowCount() - 1, false);
+}
+
+void Column::SetNull(size_t row) {
+    if (row >= GetRowCount()) {
+        throw std::out_of_range("Row index out of range: " +
+                                std::to_string(row));
+    }
+    GetMutableValidity().Set(row, false);
+}
+
+void Column::SetValidity(std::optional<Bitmap> validity) {
+    if (validity && validity->size() != GetRowCount()) {
+        throw std::invalid_argument(
+            "Validity size mismatch for column " + name_ + ": " +
+            std::to_string(validity->size()) + " bits for " +
+            std::to_string(GetRowCount()) + " rows");
+    }
+
+    if (validity && validity->CountSet() == validity->size()) {
+        validity.reset();
+    }
+    validity_ = std::move(validity);
+}
+
+Bitmap& Column::GetMutableValidity() {
+    if (!validity_) {
+        validity_.emplace(GetRowCount(), true);
+    } else if (validity_->size() < GetRowCount()) {
+        validity_->resize(GetRowCount(), true);
+    }
+    return *validity_;
 }
 
 void Column::Reserve(size_t capacity) {
@@ -117,6 +246,7 @@ void Column::Reserve(size_t capacity) {
 
 void Column::Clear() {
     std::visit(Types::ClearVisitor{}, data_);
+    validity_.reset();
 }
 
 }  // namespace Columnar
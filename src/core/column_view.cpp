@@ -0,0 +1,77 @@
+#include <core/column_view.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace Columnar {
+
+namespace {
+
+template <typename T>
+std::vector<T> CopyToVector(const void* data, size_t rowCount) {
+    std::vector<T> vec(rowCount);
+    std::memcpy(vec.data(), data, rowCount * sizeof(T));
+    return vec;
+}
+
+}  // namespace
+
+ColumnView::ColumnView(std::string name, Types::DataType type,
+                       const void* data, size_t rowCount,
+                       std::shared_ptr<const void> owner)
+    : name_(std::move(name)),
+      type_(type),
+      rowCount_(rowCount),
+      data_(data),
+      owner_(std::move(owner)) {}
+
+ColumnView::ColumnView(Column column)
+    : name_(column.GetName()),
+      type_(column.GetType()),
+      rowCount_(column.GetRowCount()),
+      column_(std::make_shared<const Column>(std::move(column))) {}
+
+const std::string& ColumnView::GetName() const {
+    return name_;
+}
+
+Types::DataType ColumnView::GetType() const {
+    return type_;
+}
+
+size_t ColumnView::GetRowCount() const {
+    return rowCount_;
+}
+
+bool ColumnView::IsZeroCopy() const {
+    return column_ == nullptr;
+}
+
+const Column& ColumnView::GetColumn() const {
+    if (!column_) {
+        throw std::logic_error("Column " + name_ + " is not materialized");
+    }
+    return *column_;
+}
+
+Column ColumnView::Materialize() const {
+    if (column_) {
+        return *column_;
+    }
+
+    switch (Types::GetVariantIndex(type_)) {
+        case 0:
+            return Column(name_, type_,
+                          CopyToVector<int16_t>(data_, rowCount_));
+        case 1:
+            return Column(name_, type_,
+                          CopyToVector<int32_t>(data_, rowCount_));
+        case 2:
+            return Column(name_, type_,
+                          CopyToVector<int64_t>(data_, rowCount_));
+        default:
+            throw std::logic_error("Unexpected zero-copy column type");
+    }
+}
+
+}  // namespace Columnar
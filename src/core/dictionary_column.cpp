@@ -0,0 +1,34 @@
+#include <core/dictionary_column.h>
+
+#include <stdexcept>
+
+namespace Columnar {
+
+size_t DictionaryColumn::GetRowCount() const {
+    return codes.size();
+}
+
+Column DictionaryColumn::Materialize() const {
+    auto offsets = dictionary.GetOffsets();
+    size_t totalLength = 0;
+    for (uint32_t code : codes) {
+        if (code >= dictionary.size()) {
+            throw std::out_of_range("Dictionary code out of range: " +
+                                    std::to_string(code));
+        }
+        totalLength += offsets[code + 1] - offsets[code];
+    }
+
+    StringVector values;
+    values.reserve(codes.size(), totalLength);
+
+    for (uint32_t code : codes) {
+        values.push_back(dictionary[code]);
+    }
+
+    Column column = Column::CreateString(name, std::move(values));
+    column.SetValidity(validity);
+    return column;
+}
+
+}  // namespace Columnar
@@ -0,0 +1,177 @@
+#include <core/german_string.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace Columnar {
+
+namespace {
+
+// First 4 bytes as a big-endian number: integer order is byte order, and
+// the zero padding of short strings sorts before any other byte
+uint32_t GetPrefixKey(std::string_view prefix) {
+    unsigned char bytes[4] = {};
+    std::memcpy(bytes, prefix.data(), prefix.size());
+    return (uint32_t{bytes[0]} << 24) | (uint32_t{bytes[1]} << 16) |
+           (uint32_t{bytes[2]} << 8) | uint32_t{bytes[3]};
+}
+
+}  // namespace
+
+GermanString GermanString::Make(std::string_view value, const char* data) {
+    if (value.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("String value exceeds 4 GiB");
+    }
+
+    GermanString entry;
+    entry.length_ = static_cast<uint32_t>(value.size());
+    std::memcpy(entry.prefix_, value.data(),
+                std::min(value.size(), kPrefixLength));
+
+    if (entry.IsInline()) {
+        if (value.size() > kPrefixLength) {
+            std::memcpy(entry.inline_, value.data() + kPrefixLength,
+                        value.size() - kPrefixLength);
+        }
+    } else {
+        entry.pointer_ = data;
+    }
+    return entry;
+}
+
+uint64_t GermanString::GetHead() const {
+    uint64_t head;
+    std::memcpy(&head, this, sizeof(head));
+    return head;
+}
+
+bool GermanString::StartsWith(std::string_view prefix) const {
+    if (prefix.size() > length_) {
+        return false;
+    }
+
+    size_t head = std::min(prefix.size(), kPrefixLength);
+    if (std::memcmp(prefix_, prefix.data(), head) != 0) {
+        return false;
+    }
+    return prefix.size() <= kPrefixLength ||
+           view().substr(0, prefix.size()) == prefix;
+}
+
+bool operator==(const GermanString& lhs, const GermanString& rhs) {
+    // length and prefix
+    if (lhs.GetHead() != rhs.GetHead()) {
+        return false;
+    }
+
+    if (lhs.IsInline()) {
+        return std::memcmp(lhs.inline_, rhs.inline_, sizeof(lhs.inline_)) == 0;
+    }
+    return std::memcmp(lhs.pointer_ + GermanString::kPrefixLength,
+                       rhs.pointer_ + GermanString::kPrefixLength,
+                       lhs.length_ - GermanString::kPrefixLength) == 0;
+}
+
+std::strong_ordering operator<=>(const GermanString& lhs,
+                                 const GermanString& rhs) {
+    uint32_t lhsKey = GetPrefixKey(lhs.GetPrefix());
+    uint32_t rhsKey = GetPrefixKey(rhs.GetPrefix());
+    if (lhsKey != rhsKey) {
+        return lhsKey <=> rhsKey;
+    }
+    return lhs.view() <=> rhs.view();
+}
+
+GermanStringVector::GermanStringVector(const StringVector& values) {
+    reserve(values.size());
+    for (std::string_view value : values) {
+        push_back(value);
+    }
+}
+
+GermanStringVector::GermanStringVector(const GermanStringVector& other) {
+    reserve(other.size());
+    for (const GermanString& value : other) {
+        push_back(value.view());
+    }
+}
+
+GermanStringVector& GermanStringVector::operator=(
+    const GermanStringVector& other) {
+    if (this != &other) {
+        GermanStringVector copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+GermanStringVector::GermanStringVector(GermanStringVector&& other) noexcept
+    : entries_(std::move(other.entries_)),
+      blocks_(std::move(other.blocks_)),
+      blockPos_(std::exchange(other.blockPos_, nullptr)),
+      blockLeft_(std::exchange(other.blockLeft_, 0)),
+      arenaSize_(std::exchange(other.arenaSize_, 0)) {
+    other.entries_.clear();
+    other.blocks_.clear();
+}
+
+GermanStringVector& GermanStringVector::operator=(
+    GermanStringVector&& other) noexcept {
+    if (this != &other) {
+        entries_ = std::move(other.entries_);
+        blocks_ = std::move(other.blocks_);
+        blockPos_ = std::exchange(other.blockPos_, nullptr);
+        blockLeft_ = std::exchange(other.blockLeft_, 0);
+        arenaSize_ = std::exchange(other.arenaSize_, 0);
+        other.entries_.clear();
+        other.blocks_.clear();
+    }
+    return *this;
+}
+
+void GermanStringVector::push_back(std::string_view value) {
+    const char* data = nullptr;
+    if (value.size() > GermanString::kInlineLength) {
+        data = Store(value);
+    }
+    entries_.push_back(GermanString::Make(value, data));
+}
+
+const char* GermanStringVector::Store(std::string_view value) {
+    // large values get a block of their own, the current block stays open
+    if (value.size() > kArenaBlockSize / 4) {
+        blocks_.push_back(std::make_unique<char[]>(value.size()));
+        std::memcpy(blocks_.back().get(), value.data(), value.size());
+        arenaSize_ += value.size();
+        return blocks_.back().get();
+    }
+
+    if (value.size() > blockLeft_) {
+        blocks_.push_back(std::make_unique<char[]>(kArenaBlockSize));
+        blockPos_ = blocks_.back().get();
+        blockLeft_ = kArenaBlockSize;
+    }
+
+    char* data = blockPos_;
+    std::memcpy(data, value.data(), value.size());
+    blockPos_ += value.size();
+    blockLeft_ -= value.size();
+    arenaSize_ += value.size();
+    return data;
+}
+
+void GermanStringVector::reserve(size_t capacity) {
+    entries_.reserve(capacity);
+}
+
+void GermanStringVector::clear() {
+    entries_.clear();
+    blocks_.clear();
+    blockPos_ = nullptr;
+    blockLeft_ = 0;
+    arenaSize_ = 0;
+}
+
+}  // namespace Columnar
@@ -0,0 +1,111 @@
+#include <core/string_vector.h>
+
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace Columnar {
+
+StringVector::StringVector()
+    : offsets_{0} {}
+
+StringVector::StringVector(std::initializer_list<std::string_view> values)
+    : StringVector() {
+    reserve(values.size());
+    for (std::string_view value : values) {
+        push_back(value);
+    }
+}
+
+StringVector::StringVector(const std::vector<std::string>& values)
+    : StringVector() {
+    size_t totalLength = 0;
+    for (const auto& value : values) {
+        totalLength += value.size();
+    }
+
+    reserve(values.size(), totalLength);
+    for (const auto& value : values) {
+        push_back(value);
+    }
+}
+
+StringVector::StringVector(std::vector<uint32_t> offsets,
+                           std::vector<char> chars)
+    : offsets_(std::move(offsets)),
+      chars_(std::move(chars)) {
+    if (offsets_.empty() || offsets_.front() != 0) {
+        throw std::invalid_argument("String offsets must start with 0");
+    }
+
+    for (size_t i = 1; i < offsets_.size(); ++i) {
+        if (offsets_[i] < offsets_[i - 1]) {
+            throw std::invalid_argument("String offsets must not decrease");
+        }
+    }
+
+    if (offsets_.back() != chars_.size()) {
+        throw std::invalid_argument(
+            "String offsets do not match character data size");
+    }
+}
+
+StringVector::StringVector(StringVector&& other) noexcept
+    : offsets_(std::exchange(other.offsets_, {0})),
+      chars_(std::move(other.chars_)) {
+    other.chars_.clear();
+}
+
+StringVector& StringVector::operator=(StringVector&& other) noexcept {
+    if (this != &other) {
+        offsets_ = std::exchange(other.offsets_, {0});
+        chars_ = std::move(other.chars_);
+        other.chars_.clear();
+    }
+    return *this;
+}
+
+std::string_view StringVector::at(size_t index) const {
+    if (index >= size()) {
+        throw std::out_of_range("Row index out of range: " +
+                                std::to_string(index));
+    }
+    return (*this)[index];
+}
+
+std::span<const uint32_t> StringVector::GetOffsets() const {
+    return offsets_;
+}
+
+std::span<const char> StringVector::GetChars() const {
+    return chars_;
+}
+
+void StringVector::push_back(std::string_view value) {
+    if (chars_.size() + value.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("String column exceeds 4 GiB of characters");
+    }
+
+    chars_.insert(chars_.end(), value.begin(), value.end());
+    offsets_.push_back(static_cast<uint32_t>(chars_.size()));
+}
+
+void StringVector::reserve(size_t capacity) {
+    offsets_.reserve(capacity + 1);
+}
+
+void StringVector::reserve(size_t capacity, size_t charsCapacity) {
+    offsets_.reserve(capacity + 1);
+    chars_.reserve(charsCapacity);
+}
+
+void StringVector::clear() {
+    offsets_.resize(1);
+    chars_.clear();
+}
+
+bool StringVector::operator==(const StringVector& other) const {
+    return offsets_ == other.offsets_ && chars_ == other.chars_;
+}
+
+}  // namespace Columnar
@@ -1,5 +1,7 @@
 #include <core/types.h>
 
+#include <stdexcept>
+
 namespace Columnar::Types {
 
 size_t GetTypeSize(DataType type) {
@@ -104,9 +106,9 @@ AnyColumnData CreateEmptyColumnData(DataType type) {
         case DataType::TIMESTAMP:
             return std::vector<int64_t>();
         case DataType::BOOL:
-            return std::vector<bool>();
+            return Bitmap();
         case DataType::STRING:
-            return std::vector<std::string>();
+            return StringVector();
         default:
             throw std::invalid_argument("Unknown data type");
     }
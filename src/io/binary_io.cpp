@@ -1,13 +1,21 @@
 #include <io/binary_io.h>
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
 #include <cstdint>
+#include <cstring>
 #include <ios>
 #include <stdexcept>
+#include <utility>
 
 namespace Columnar::IO {
 
 BinaryWriter::BinaryWriter(const std::string& filename)
-    : file_(filename, std::ios::binary) {
+    : file_(filename, std::ios::binary),
+      buffer_(kWriteBufferSize) {
     if (!file_.is_open()) {
         throw std::runtime_error("Cannot open file for writing: " + filename);
     }
@@ -15,13 +23,29 @@ BinaryWriter::BinaryWriter(const std::string& filename)
 
 BinaryWriter::~BinaryWriter() {
     if (file_.is_open()) {
+        try {
+            FlushBuffer();
+        } catch (...) {}
         file_.close();
     }
 }
 
 void BinaryWriter::Write(const void* data, size_t size) {
-    file_.write(reinterpret_cast<const char*>(data),
-                static_cast<std::streamsize>(size));
+    if (buffered_ + size > buffer_.size()) {
+        FlushBuffer();
+    }
+
+    if (size >= buffer_.size()) {
+        file_.write(reinterpret_cast<const char*>(data),
+                    static_cast<std::streamsize>(size));
+        if (!file_) {
+            throw std::runtime_error("Write to file failed");
+        }
+        return;
+    }
+
+    std::memcpy(buffer_.data() + buffered_, data, size);
+    buffered_ += size;
 }
 
 void BinaryWriter::WriteString(const std::string& str) {
@@ -33,38 +57,102 @@ void BinaryWriter::WriteString(const std::string& str) {
     }
 }
 
+void BinaryWriter::WritePadding(size_t alignment) {
+    static constexpr char kZeros[64] = {};
+
+    size_t remainder = GetPosition() % alignment;
+    if (remainder != 0) {
+        Write(kZeros, alignment - remainder);
+    }
+}
+
 size_t BinaryWriter::GetPosition() {
-    return static_cast<size_t>(file_.tellp());
+    return static_cast<size_t>(file_.tellp()) + buffered_;
 }
 
 void BinaryWriter::Seek(size_t pos) {
+    FlushBuffer();
     file_.seekp(static_cast<std::streamoff>(pos), std::ios::beg);
 }
 
 void BinaryWriter::Flush() {
+    FlushBuffer();
     file_.flush();
 }
 
+void BinaryWriter::FlushBuffer() {
+    if (buffered_ == 0) {
+        return;
+    }
+
+    file_.write(buffer_.data(), static_cast<std::streamsize>(buffered_));
+    buffered_ = 0;
+    if (!file_) {
+        throw std::runtime_error("Write to file failed");
+    }
+}
+
 BinaryReader::BinaryReader(const std::string& filename)
-    : file_(filename, std::ios::binary) {
-    if (!file_.is_open()) {
+    : fd_(::open(filename.c_str(), O_RDONLY | O_CLOEXEC)) {
+    if (fd_ < 0) {
         throw std::runtime_error("Cannot open file for reading: " + filename);
     }
 
-    file_.seekg(0, std::ios::end);
-    fileSize_ = static_cast<size_t>(file_.tellg());
-    file_.seekg(0, std::ios::beg);
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+        ::close(fd_);
+        throw std::runtime_error("Cannot stat file: " + filename);
+    }
+    fileSize_ = static_cast<size_t>(st.st_size);
+}
+
+BinaryReader::BinaryReader(BinaryReader&& other) noexcept
+    : fd_(std::exchange(other.fd_, -1)),
+      position_(other.position_),
+      fileSize_(other.fileSize_) {}
+
+BinaryReader& BinaryReader::operator=(BinaryReader&& other) noexcept {
+    if (this != &other) {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        fd_ = std::exchange(other.fd_, -1);
+        position_ = other.position_;
+        fileSize_ = other.fileSize_;
+    }
+    return *this;
 }
 
 BinaryReader::~BinaryReader() {
-    if (file_.is_open()) {
-        file_.close();
+    if (fd_ >= 0) {
+        ::close(fd_);
     }
 }
 
 void BinaryReader::Read(void* buffer, size_t size) {
-    file_.read(reinterpret_cast<char*>(buffer),
-               static_cast<std::streamsize>(size));
+    ReadAt(position_, buffer, size);
+    position_ += size;
+}
+
+void BinaryReader::ReadAt(uint64_t offset, void* buffer, size_t size) const {
+    char* out = static_cast<char*>(buffer);
+    while (size > 0) {
+        ssize_t n = ::pread(fd_, out, size, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(std::string("Read failed: ") +
+                                     std::strerror(errno));
+        }
+        if (n == 0) {
+            throw std::runtime_error("Unexpected end of file");
+        }
+
+        out += n;
+        offset += static_cast<uint64_t>(n);
+        size -= static_cast<size_t>(n);
+    }
 }
 
 std::string BinaryReader::ReadString() {
@@ -79,16 +167,67 @@ std::string BinaryReader::ReadString() {
     return result;
 }
 
-size_t BinaryReader::GetPosition() {
-    return static_cast<size_t>(file_.tellg());
+size_t BinaryReader::GetPosition() const {
+    return position_;
 }
 
 void BinaryReader::Seek(size_t pos) {
-    file_.seekg(static_cast<std::streamoff>(pos), std::ios::beg);
+    position_ = pos;
 }
 
 size_t BinaryReader::GetFileSize() const {
     return fileSize_;
 }
 
+BufferReader::BufferReader(const char* data, size_t size)
+    : data_(data),
+      size_(size) {}
+
+void BufferReader::Read(void* buffer, size_t size) {
+    std::memcpy(buffer, ReadBytes(size), size);
+}
+
+std::string BufferReader::ReadString() {
+    uint32_t length;
+    Read(&length, sizeof(length));
+    if (length == 0) {
+        return {};
+    }
+
+    const char* bytes = ReadBytes(length);
+    return std::string(bytes, length);
+}
+
+const char* BufferReader::ReadBytes(size_t size) {
+    if (size > size_ - position_) {
+        throw std::runtime_error("Unexpected end of buffer");
+    }
+
+    const char* result = data_ + position_;
+    position_ += size;
+    return result;
+}
+
+void BufferReader::SkipPadding(size_t alignment) {
+    size_t remainder = position_ % alignment;
+    if (remainder != 0) {
+        ReadBytes(alignment - remainder);
+    }
+}
+
+size_t BufferReader::GetPosition() const {
+    return position_;
+}
+
+void BufferReader::Seek(size_t pos) {
+    if (pos > size_) {
+        throw std::out_of_range("Seek past end of buffer");
+    }
+    position_ = pos;
+}
+
+size_t BufferReader::GetSize() const {
+    return size_;
+}
+
 }  // namespace Columnar::IO
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include <io/csv_export.h>
+#include <io/csv_writer.h>
+#include <util/thread_pool.h>
+
+#include <deque>
+#include <future>
+#include <memory>
+#include <stdexcept>
+
+namespace Columnar::IO {
+
+namespace {
+
+struct FormattedRowGroup {
+    std::vector<char> text;
+    size_t rowCount = 0;
+};
+
+}  // namespace
+
+size_t ExportCsv(const FormatReader& reader,
+                 const std::vector<std::string>& filenames,
+                 const CsvExportOptions& options) {
+    if (filenames.empty()) {
+        throw std::invalid_argument("No output files for CSV export");
+    }
+
+    ThreadPool pool(options.threads);
+    size_t maxInFlight = options.maxInFlight > 0
+                             ? options.maxInFlight
+                             : 2 * pool.GetThreadCount();
+
+    size_t rowGroupCount = reader.GetRowGroupCount();
+    size_t fileCount = filenames.size();
+    // file k receives row groups [k * count / files, (k + 1) * count / files)
+    auto firstOf = [&](size_t file) {
+        return file * rowGroupCount / fileCount;
+    };
+
+    std::deque<std::future<FormattedRowGroup>> pending;
+    auto submit = [&](size_t index) {
+        pending.push_back(pool.Submit([&reader, &options, index] {
+            RowGroup rowGroup = reader.ReadRowGroup(index);
+
+            FormattedRowGroup formatted;
+            formatted.rowCount = rowGroup.GetBatch().GetRowCount();
+            CsvFormatter formatter(options.csv);
+            formatter.Format(rowGroup.GetBatch(), formatted.text);
+            return formatted;
+        }));
+    };
+
+    size_t submitted = 0;
+    size_t totalRows = 0;
+    for (size_t file = 0; file < fileCount; ++file) {
+        CsvWriter writer(filenames[file]);
+
+        size_t end = firstOf(file + 1);
+        for (size_t index = firstOf(file); index < end; ++index) {
+            while (submitted < rowGroupCount && pending.size() < maxInFlight) {
+                submit(submitted++);
+            }
+
+            FormattedRowGroup formatted = pending.front().get();
+            pending.pop_front();
+            writer.WriteFormatted(formatted.text, formatted.rowCount);
+            totalRows += formatted.rowCount;
+
+            if (options.onRowGroupWritten) {
+                options.onRowGroupWritten(index, formatted.rowCount);
+            }
+        }
+
+        writer.Flush();
+    }
+
+    return totalRows;
+}
+
+}  // namespace Columnar::IO
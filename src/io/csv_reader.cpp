@@ -2,7 +2,10 @@
 #include <core/schema.h>
 
 #include <io/csv_reader.h>
-#include <parser/csv_parser.h>
+#include <parser/csv_column_parser.h>
+#include <parser/csv_tokenizer.h>
+
+#include <algorithm>
 
 #include <optional>
 #include <stdexcept>
@@ -22,55 +25,104 @@ CsvReader::CsvReader(const std::string& filename, const Schema& schema)
     }
 }
 
+// Lines of a batch are collected into one block, tokenized at once and
+// parsed column-at-a-time into typed column buffers
 std::optional<Batch> CsvReader::ReadBatch() {
     if (IsEnd()) {
         return std::nullopt;
     }
 
-    Batch batch = Batch::CreateEmpty(schema_);
-    batch.Reserve(kBatchSize);
-
-    while (!batch.IsFull() && !IsEnd()) {
-        auto line = ReadLine();
-        if (!line || line->empty()) {
+    block_.clear();
+    lineStarts_.clear();
+    lineNumbers_.clear();
+    size_t firstLine = lineNumber_ + 1;
+
+    // A batch is closed only between records: lines are added while a
+    // quoted field is still open, whatever the record count. Blank lines
+    // are skipped only outside quoted fields.
+    size_t recordCount = 0;
+    bool inQuotes = false;
+    while ((recordCount < kBatchSize || inQuotes) && ReadLine()) {
+        if (line_.empty() && !inQuotes) {
             continue;
         }
-        ParseAndAppendRow(std::move(*line), batch);
+        if (!inQuotes) {
+            ++recordCount;
+        }
+        lineStarts_.push_back(block_.size());
+        lineNumbers_.push_back(lineNumber_);
+        block_ += line_;
+        block_ += '\n';
+
+        if (std::count(line_.begin(), line_.end(), options_.quote) % 2 != 0) {
+            inQuotes = !inQuotes;
+        }
     }
 
-    if (batch.IsEmpty()) {
+    if (lineStarts_.empty()) {
         return std::nullopt;
     }
 
-    return batch;
+    try {
+        Parser::TokenizeCsv(block_, tokens_, options_);
+    } catch (const std::exception& e) {
+        throw std::runtime_error(std::string(e.what()) + " in lines " +
+                                 std::to_string(firstLine) + "-" +
+                                 std::to_string(lineNumber_));
+    }
+
+    records_.clear();
+    size_t field = 0;
+    for (uint32_t recordEnd : tokens_.recordEnds) {
+        size_t fieldCount = recordEnd - field;
+        if (fieldCount != schema_.GetColumnCount()) {
+            throw std::runtime_error(
+                "Field count mismatch at line " +
+                std::to_string(GetLineNumber(tokens_.GetFieldBegin(field))) +
+                ": expected " + std::to_string(schema_.GetColumnCount()) +
+                ", got " + std::to_string(fieldCount));
+        }
+        records_.push_back(static_cast<uint32_t>(field));
+        field = recordEnd;
+    }
+
+    std::vector<Column> columns;
+    columns.reserve(schema_.GetColumnCount());
+    for (size_t c = 0; c < schema_.GetColumnCount(); ++c) {
+        const auto& colSchema = schema_.GetColumn(c);
+        columns.emplace_back(colSchema.name, colSchema.type);
+        try {
+            Parser::AppendCsvColumn(block_, tokens_, records_, c,
+                                    columns.back(), options_);
+        } catch (const std::invalid_argument& e) {
+            throw std::invalid_argument("Column " + colSchema.name +
+                                        " in lines " +
+                                        std::to_string(firstLine) + "-" +
+                                        std::to_string(lineNumber_) + ": " +
+                                        e.what());
+        }
+    }
+
+    totalRowsRead_ += records_.size();
+    return Batch(schema_, std::move(columns));
 }
 
 bool CsvReader::IsEnd() const {
     return (!file_.good()) || (file_.eof());
 }
 
-std::optional<std::string> CsvReader::ReadLine() {
-    std::string line;
-    if (std::getline(file_, line)) {
+bool CsvReader::ReadLine() {
+    if (std::getline(file_, line_)) {
         ++lineNumber_;
-        return line;
+        return true;
     }
 
-    return std::nullopt;
+    return false;
 }
 
-void CsvReader::ParseAndAppendRow(std::string&& line, Batch& batch) {
-    auto fields = Parser::ParseCsvLine(std::move(line));
-
-    if (fields.size() != schema_.GetColumnCount()) {
-        throw std::runtime_error("Field count mismatch at line " +
-                                 std::to_string(lineNumber_) + ": expected " +
-                                 std::to_string(schema_.GetColumnCount()) +
-                                 ", got " + std::to_string(fields.size()));
-    }
-
-    batch.AppendRow(std::move(fields));
-    ++totalRowsRead_;
+size_t CsvReader::GetLineNumber(size_t offset) const {
+    auto it = std::upper_bound(lineStarts_.begin(), lineStarts_.end(), offset);
+    return lineNumbers_[it - lineStarts_.begin() - 1];
 }
 
 const Schema& CsvReader::GetSchema() const {
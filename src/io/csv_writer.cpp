@@ -1,38 +1,207 @@
 #include <core/batch.h>
 
 #include <io/csv_writer.h>
-#include <parser/csv_parser.h>
+#include <parser/value_parser.h>
 
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <span>
 #include <stdexcept>
 #include <vector>
 
 namespace Columnar::IO {
 
-CsvWriter::CsvWriter(const std::string& filename)
-    : file_(filename) {
+namespace {
+
+bool NeedsEscaping(std::string_view text,
+                   const Parser::CsvParserOptions& options) {
+    for (char c : text) {
+        if (c == options.delimiter || c == options.quote || c == '\n' ||
+            c == '\r') {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+void FormatIntegers(const std::vector<T>& vec, Types::DataType type,
+                    const Bitmap* validity, StringVector& out) {
+    char text[32];
+    for (size_t i = 0; i < vec.size(); ++i) {
+        if (validity && !(*validity)[i]) {
+            out.push_back({});
+            continue;
+        }
+
+        T value = vec[i];
+        char* end;
+        if (type == Types::DataType::DATE) {
+            end = Parser::FormatDate(static_cast<int32_t>(value), text);
+        } else if (type == Types::DataType::TIMESTAMP) {
+            end = Parser::FormatTimestamp(static_cast<int64_t>(value), text);
+        } else {
+            end = std::to_chars(text, text + sizeof(text), value).ptr;
+        }
+        out.push_back({text, static_cast<size_t>(end - text)});
+    }
+}
+
+// Returns the text of every value of `column`: the column's own strings when
+// none of them has to be quoted, `out` filled with formatted values
+// otherwise. NULL rows are empty.
+const StringVector& FormatColumn(const Column& column, StringVector& out,
+                                 const Parser::CsvParserOptions& options) {
+    out.clear();
+    const Bitmap* validity = column.GetValidity();
+
+    return std::visit(
+        Types::overloaded{
+            [&](const StringVector& vec) -> const StringVector& {
+                auto chars = vec.GetChars();
+                if (!validity &&
+                    !NeedsEscaping({chars.data(), chars.size()}, options)) {
+                    return vec;
+                }
+
+                std::string escaped;
+                out.reserve(vec.size(), chars.size() + vec.size());
+                for (size_t i = 0; i < vec.size(); ++i) {
+                    std::string_view value = vec[i];
+                    if (validity && !(*validity)[i]) {
+                        out.push_back({});
+                        continue;
+                    }
+                    if (!NeedsEscaping(value, options)) {
+                        out.push_back(value);
+                        continue;
+                    }
+
+                    escaped.assign(1, options.quote);
+                    for (char c : value) {
+                        if (c == options.quote) {
+                            escaped += options.quote;
+                        }
+                        escaped += c;
+                    }
+                    escaped += options.quote;
+                    out.push_back(escaped);
+                }
+                return out;
+            },
+            [&](const Bitmap& vec) -> const StringVector& {
+                out.reserve(vec.size(), vec.size() * 5);
+                for (size_t i = 0; i < vec.size(); ++i) {
+                    if (validity && !(*validity)[i]) {
+                        out.push_back({});
+                    } else {
+                        out.push_back(vec[i] ? "true" : "false");
+                    }
+                }
+                return out;
+            },
+            [&](const auto& vec) -> const StringVector& {
+                out.reserve(vec.size());
+                FormatIntegers(vec, column.GetType(), validity, out);
+                return out;
+            }},
+        column.GetData());
+}
+
+}  // namespace
+
+CsvFormatter::CsvFormatter(Parser::CsvParserOptions options)
+    : options_(options) {}
+
+void CsvFormatter::Format(const Batch& batch, std::vector<char>& out) {
+    size_t columnCount = batch.GetColumnCount();
+    size_t rowCount = batch.GetSelectedRowCount();
+    const std::vector<uint32_t>* selection = batch.GetSelection();
+    formatted_.resize(columnCount);
+
+    // every row has columnCount - 1 delimiters and a newline
+    size_t textSize = rowCount * std::max<size_t>(columnCount, 1);
+    std::vector<std::span<const uint32_t>> offsets(columnCount);
+    std::vector<const char*> chars(columnCount);
+    for (size_t col = 0; col < columnCount; ++col) {
+        const StringVector& text =
+            FormatColumn(batch.GetColumn(col), formatted_[col], options_);
+        offsets[col] = text.GetOffsets();
+        chars[col] = text.GetChars().data();
+
+        if (!selection) {
+            textSize += offsets[col].back();
+            continue;
+        }
+        for (uint32_t row : *selection) {
+            textSize += offsets[col][row + 1] - offsets[col][row];
+        }
+    }
+
+    size_t begin = out.size();
+    out.resize(begin + textSize);
+
+    char* pos = out.data() + begin;
+    for (size_t i = 0; i < rowCount; ++i) {
+        size_t row = selection ? (*selection)[i] : i;
+        for (size_t col = 0; col < columnCount; ++col) {
+            if (col > 0) {
+                *pos++ = options_.delimiter;
+            }
+            uint32_t first = offsets[col][row];
+            uint32_t length = offsets[col][row + 1] - first;
+            std::memcpy(pos, chars[col] + first, length);
+            pos += length;
+        }
+        *pos++ = '\n';
+    }
+}
+
+CsvWriter::CsvWriter(const std::string& filename, CsvWriterOptions options)
+    : file_(filename, std::ios::binary),
+      options_(options),
+      formatter_(options.csv) {
     if (!file_.is_open()) {
         throw std::runtime_error("Cannot open CSV file for writing: " +
                                  filename);
     }
+    buffer_.reserve(options_.bufferSize);
 }
 
 void CsvWriter::WriteBatch(const Batch& batch) {
-    Schema schema = batch.GetSchema();
+    formatter_.Format(batch, buffer_);
+    rowsWritten_ += batch.GetSelectedRowCount();
 
-    for (size_t row = 0; row < batch.GetRowCount(); ++row) {
-        std::vector<std::string> fields;
-        fields.reserve(batch.GetColumnCount());
+    if (buffer_.size() >= options_.bufferSize) {
+        WriteBuffer();
+    }
+}
 
-        for (size_t col = 0; col < batch.GetColumnCount(); ++col) {
-            fields.push_back(batch.GetColumn(col).GetValueAsString(row));
+void CsvWriter::WriteFormatted(std::span<const char> text, size_t rowCount) {
+    if (buffer_.size() + text.size() < options_.bufferSize) {
+        buffer_.insert(buffer_.end(), text.begin(), text.end());
+    } else {
+        // large blocks bypass the buffer
+        WriteBuffer();
+        file_.write(text.data(), static_cast<std::streamsize>(text.size()));
+        if (!file_) {
+            throw std::runtime_error("Failed to write CSV file");
         }
+    }
+    rowsWritten_ += rowCount;
+}
 
-        file_ << Parser::MergeFieldsInLine(fields) << '\n';
-        ++rowsWritten_;
+void CsvWriter::WriteBuffer() {
+    file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    if (!file_) {
+        throw std::runtime_error("Failed to write CSV file");
     }
+    buffer_.clear();
 }
 
 void CsvWriter::Flush() {
+    WriteBuffer();
     file_.flush();
 }
 
@@ -41,7 +210,9 @@ size_t CsvWriter::GetRowsWritten() const {
 }
 
 CsvWriter::~CsvWriter() {
-    Flush();
+    try {
+        Flush();
+    } catch (...) {}
     if (file_.is_open()) {
         file_.close();
     }
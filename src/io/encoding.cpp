@@ -0,0 +1,513 @@
+#include <io/encoding.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace Columnar::IO {
+
+namespace {
+
+constexpr size_t kWordBits = 64;
+
+// FOR header: base (8) + bit width (1) + padding (7)
+constexpr size_t kForHeaderSize = 16;
+// DELTA header: first value (8) + min delta (8) + bit width (1) + padding (7)
+constexpr size_t kDeltaHeaderSize = 24;
+// RLE header: run count (4) + padding (4)
+constexpr size_t kRleHeaderSize = 8;
+// Dictionary header: entry count (4) + padding (4), codes header: width (1) +
+// padding (7)
+constexpr size_t kDictionaryHeaderSize = 16;
+
+size_t AlignUp(size_t value) {
+    return (value + 7) / 8 * 8;
+}
+
+template <typename T>
+void Append(std::vector<char>& out, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void AppendPadding(std::vector<char>& out) {
+    out.resize(AlignUp(out.size()), 0);
+}
+
+// Unpacks one block of 64 values with compile-time width. Every value is read
+// from two neighbouring words, the extra zero word keeps it branch-free.
+template <size_t W, typename T>
+void UnpackBlock(const char* in, uint64_t base, T* out) {
+    if constexpr (W == 0) {
+        std::fill_n(out, kBitPackBlockSize, static_cast<T>(base));
+    } else {
+        uint64_t words[W + 1];
+        std::memcpy(words, in, W * sizeof(uint64_t));
+        words[W] = 0;
+
+        constexpr uint64_t kMask =
+            W == kWordBits ? ~uint64_t{0} : (uint64_t{1} << W) - 1;
+
+        for (size_t i = 0; i < kBitPackBlockSize; ++i) {
+            const size_t bit = i * W;
+            const size_t word = bit / kWordBits;
+            const size_t shift = bit % kWordBits;
+
+            uint64_t high = (words[word + 1] << 1) << (kWordBits - 1 - shift);
+            uint64_t value = (words[word] >> shift) | high;
+            out[i] = static_cast<T>(base + (value & kMask));
+        }
+    }
+}
+
+template <typename T>
+using UnpackBlockFn = void (*)(const char*, uint64_t, T*);
+
+template <typename T, size_t... W>
+constexpr auto MakeUnpackTable(std::index_sequence<W...>) {
+    return std::array<UnpackBlockFn<T>, sizeof...(W)>{&UnpackBlock<W, T>...};
+}
+
+template <typename T>
+constexpr auto kUnpackTable =
+    MakeUnpackTable<T>(std::make_index_sequence<kWordBits + 1>{});
+
+struct IntegerStats {
+    uint64_t min = 0;  // as signed value, stored in two's complement
+    uint64_t range = 0;
+    uint64_t minDelta = 0;
+    uint64_t deltaRange = 0;
+    size_t runCount = 0;
+};
+
+template <typename T>
+IntegerStats CollectStats(std::span<const T> values) {
+    IntegerStats stats;
+
+    auto [minIt, maxIt] = std::minmax_element(values.begin(), values.end());
+    stats.min = static_cast<uint64_t>(static_cast<int64_t>(*minIt));
+    stats.range =
+        static_cast<uint64_t>(static_cast<int64_t>(*maxIt)) - stats.min;
+
+    int64_t minDelta = std::numeric_limits<int64_t>::max();
+    int64_t maxDelta = std::numeric_limits<int64_t>::min();
+    stats.runCount = 1;
+
+    for (size_t i = 1; i < values.size(); ++i) {
+        // deltas wrap around, decoding uses the same modular arithmetic
+        int64_t delta = static_cast<int64_t>(
+            static_cast<uint64_t>(static_cast<int64_t>(values[i])) -
+            static_cast<uint64_t>(static_cast<int64_t>(values[i - 1])));
+        minDelta = std::min(minDelta, delta);
+        maxDelta = std::max(maxDelta, delta);
+        stats.runCount += values[i] != values[i - 1];
+    }
+
+    if (values.size() > 1) {
+        stats.minDelta = static_cast<uint64_t>(minDelta);
+        stats.deltaRange = static_cast<uint64_t>(maxDelta) - stats.minDelta;
+    }
+
+    return stats;
+}
+
+template <typename T>
+size_t GetRleSize(size_t runCount) {
+    return kRleHeaderSize + AlignUp(runCount * sizeof(T)) +
+           runCount * sizeof(uint32_t);
+}
+
+template <typename T>
+void EncodeFor(std::span<const T> values, const IntegerStats& stats,
+               std::vector<char>& out) {
+    uint8_t width = static_cast<uint8_t>(GetBitWidth(stats.range));
+    Append(out, stats.min);
+    Append(out, width);
+    AppendPadding(out);
+
+    std::vector<uint64_t> offsets(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        offsets[i] = static_cast<uint64_t>(static_cast<int64_t>(values[i])) -
+                     stats.min;
+    }
+
+    size_t start = out.size();
+    out.resize(start + GetBitPackedSize(values.size(), width));
+    BitPack(offsets.data(), offsets.size(), width, out.data() + start);
+}
+
+template <typename T>
+void EncodeDelta(std::span<const T> values, const IntegerStats& stats,
+                 std::vector<char>& out) {
+    uint8_t width = static_cast<uint8_t>(GetBitWidth(stats.deltaRange));
+    int64_t first = static_cast<int64_t>(values[0]);
+    Append(out, first);
+    Append(out, stats.minDelta);
+    Append(out, width);
+    AppendPadding(out);
+
+    std::vector<uint64_t> deltas(values.size() - 1);
+    for (size_t i = 1; i < values.size(); ++i) {
+        uint64_t delta =
+            static_cast<uint64_t>(static_cast<int64_t>(values[i])) -
+            static_cast<uint64_t>(static_cast<int64_t>(values[i - 1]));
+        deltas[i - 1] = delta - stats.minDelta;
+    }
+
+    size_t start = out.size();
+    out.resize(start + GetBitPackedSize(deltas.size(), width));
+    BitPack(deltas.data(), deltas.size(), width, out.data() + start);
+}
+
+template <typename T>
+void EncodeRle(std::span<const T> values, const IntegerStats& stats,
+               std::vector<char>& out) {
+    uint32_t runCount = static_cast<uint32_t>(stats.runCount);
+    Append(out, runCount);
+    AppendPadding(out);
+
+    std::vector<T> runValues;
+    std::vector<uint32_t> runLengths;
+    runValues.reserve(runCount);
+    runLengths.reserve(runCount);
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i == 0 || values[i] != values[i - 1]) {
+            runValues.push_back(values[i]);
+            runLengths.push_back(0);
+        }
+        ++runLengths.back();
+    }
+
+    const char* valueBytes = reinterpret_cast<const char*>(runValues.data());
+    out.insert(out.end(), valueBytes, valueBytes + runCount * sizeof(T));
+    AppendPadding(out);
+
+    const char* lengthBytes = reinterpret_cast<const char*>(runLengths.data());
+    out.insert(out.end(), lengthBytes,
+               lengthBytes + runCount * sizeof(uint32_t));
+}
+
+template <typename T>
+void DecodeFor(BufferReader& input, std::span<T> out) {
+    uint64_t base;
+    uint8_t width;
+    input.Read(&base, sizeof(base));
+    input.Read(&width, sizeof(width));
+    input.SkipPadding(8);
+
+    if (width > kWordBits) {
+        throw std::runtime_error("Invalid bit width in encoded chunk");
+    }
+
+    const char* packed = input.ReadBytes(GetBitPackedSize(out.size(), width));
+    BitUnpack(packed, out.size(), width, base, out.data());
+}
+
+template <typename T>
+void DecodeDelta(BufferReader& input, std::span<T> out) {
+    int64_t first;
+    uint64_t minDelta;
+    uint8_t width;
+    input.Read(&first, sizeof(first));
+    input.Read(&minDelta, sizeof(minDelta));
+    input.Read(&width, sizeof(width));
+    input.SkipPadding(8);
+
+    if (width > kWordBits) {
+        throw std::runtime_error("Invalid bit width in encoded chunk");
+    }
+    if (out.empty()) {
+        return;
+    }
+
+    size_t deltaCount = out.size() - 1;
+    std::vector<uint64_t> deltas(deltaCount);
+    const char* packed = input.ReadBytes(GetBitPackedSize(deltaCount, width));
+    BitUnpack(packed, deltaCount, width, minDelta, deltas.data());
+
+    uint64_t current = static_cast<uint64_t>(first);
+    out[0] = static_cast<T>(current);
+    for (size_t i = 0; i < deltaCount; ++i) {
+        current += deltas[i];
+        out[i + 1] = static_cast<T>(current);
+    }
+}
+
+template <typename T>
+void DecodeRle(BufferReader& input, std::span<T> out) {
+    uint32_t runCount;
+    input.Read(&runCount, sizeof(runCount));
+    input.SkipPadding(8);
+
+    std::vector<T> runValues(runCount);
+    std::vector<uint32_t> runLengths(runCount);
+    input.Read(runValues.data(), runCount * sizeof(T));
+    input.SkipPadding(8);
+    input.Read(runLengths.data(), runCount * sizeof(uint32_t));
+
+    size_t position = 0;
+    for (uint32_t i = 0; i < runCount; ++i) {
+        if (runLengths[i] > out.size() - position) {
+            throw std::runtime_error("RLE runs exceed chunk row count");
+        }
+        std::fill_n(out.begin() + position, runLengths[i], runValues[i]);
+        position += runLengths[i];
+    }
+
+    if (position != out.size()) {
+        throw std::runtime_error("RLE runs do not cover chunk row count");
+    }
+}
+
+}  // namespace
+
+size_t GetBitWidth(uint64_t maxValue) {
+    return maxValue == 0 ? 0 : kWordBits - std::countl_zero(maxValue);
+}
+
+size_t GetBitPackedSize(size_t count, size_t bitWidth) {
+    size_t blocks = (count + kBitPackBlockSize - 1) / kBitPackBlockSize;
+    return blocks * bitWidth * sizeof(uint64_t);
+}
+
+void BitPack(const uint64_t* values, size_t count, size_t bitWidth,
+             char* out) {
+    if (bitWidth == 0) {
+        return;
+    }
+
+    size_t wordCount = GetBitPackedSize(count, bitWidth) / sizeof(uint64_t);
+    std::vector<uint64_t> words(wordCount + 1, 0);
+
+    for (size_t i = 0; i < count; ++i) {
+        const size_t bit = i * bitWidth;
+        const size_t word = bit / kWordBits;
+        const size_t shift = bit % kWordBits;
+
+        words[word] |= values[i] << shift;
+        if (shift + bitWidth > kWordBits) {
+            words[word + 1] |= values[i] >> (kWordBits - shift);
+        }
+    }
+
+    std::memcpy(out, words.data(), wordCount * sizeof(uint64_t));
+}
+
+template <typename T>
+void BitUnpack(const char* in, size_t count, size_t bitWidth, uint64_t base,
+               T* out) {
+    const auto unpack = kUnpackTable<T>[bitWidth];
+    const size_t blockBytes = bitWidth * sizeof(uint64_t);
+    const size_t fullBlocks = count / kBitPackBlockSize;
+
+    for (size_t block = 0; block < fullBlocks; ++block) {
+        unpack(in + block * blockBytes, base, out + block * kBitPackBlockSize);
+    }
+
+    size_t tail = count % kBitPackBlockSize;
+    if (tail != 0) {
+        T rest[kBitPackBlockSize];
+        unpack(in + fullBlocks * blockBytes, base, rest);
+        std::copy_n(rest, tail, out + fullBlocks * kBitPackBlockSize);
+    }
+}
+
+template <typename T>
+Types::Encoding EncodeIntegers(std::span<const T> values,
+                               std::vector<char>& out) {
+    if (values.empty()) {
+        return Types::Encoding::PLAIN;
+    }
+
+    IntegerStats stats = CollectStats(values);
+
+    size_t plainSize = values.size() * sizeof(T);
+    size_t forSize =
+        kForHeaderSize +
+        GetBitPackedSize(values.size(), GetBitWidth(stats.range));
+    size_t deltaSize =
+        kDeltaHeaderSize +
+        GetBitPackedSize(values.size() - 1, GetBitWidth(stats.deltaRange));
+    size_t rleSize = GetRleSize<T>(stats.runCount);
+
+    size_t best = std::min({plainSize, forSize, deltaSize, rleSize});
+    if (best == plainSize) {
+        return Types::Encoding::PLAIN;
+    }
+
+    if (best == rleSize) {
+        EncodeRle(values, stats, out);
+        return Types::Encoding::RLE;
+    }
+
+    if (best == deltaSize) {
+        EncodeDelta(values, stats, out);
+        return Types::Encoding::DELTA;
+    }
+
+    EncodeFor(values, stats, out);
+    return Types::Encoding::BIT_PACKED;
+}
+
+template <typename T>
+void DecodeIntegers(Types::Encoding encoding, BufferReader& input,
+                    std::span<T> out) {
+    switch (encoding) {
+        case Types::Encoding::PLAIN:
+            input.Read(out.data(), out.size() * sizeof(T));
+            break;
+        case Types::Encoding::BIT_PACKED:
+            DecodeFor(input, out);
+            break;
+        case Types::Encoding::DELTA:
+            DecodeDelta(input, out);
+            break;
+        case Types::Encoding::RLE:
+            DecodeRle(input, out);
+            break;
+        default:
+            throw std::runtime_error("Unsupported integer chunk encoding");
+    }
+}
+
+Types::Encoding EncodeStrings(const StringVector& values,
+                              std::vector<char>& out) {
+    if (values.empty()) {
+        return Types::Encoding::PLAIN;
+    }
+
+    std::unordered_map<std::string_view, uint32_t> ids;
+    std::vector<uint64_t> codes;
+    codes.reserve(values.size());
+
+    size_t plainSize = (values.size() + 1) * sizeof(uint32_t) +
+                       values.GetChars().size();
+    size_t dictionaryBytes = sizeof(uint32_t);
+
+    for (std::string_view value : values) {
+        auto [it, inserted] =
+            ids.try_emplace(value, static_cast<uint32_t>(ids.size()));
+        if (inserted) {
+            if (ids.size() > kMaxDictionarySize) {
+                return Types::Encoding::PLAIN;
+            }
+            dictionaryBytes += sizeof(uint32_t) + value.size();
+        }
+        codes.push_back(it->second);
+    }
+
+    size_t width = GetBitWidth(ids.size() - 1);
+    size_t dictionarySize = kDictionaryHeaderSize + AlignUp(dictionaryBytes) +
+                            GetBitPackedSize(values.size(), width);
+    if (dictionarySize >= plainSize) {
+        return Types::Encoding::PLAIN;
+    }
+
+    std::vector<std::string_view> dictionary(ids.size());
+    for (const auto& [value, id] : ids) {
+        dictionary[id] = value;
+    }
+
+    uint32_t entryCount = static_cast<uint32_t>(dictionary.size());
+    Append(out, entryCount);
+    AppendPadding(out);
+
+    uint32_t offset = 0;
+    Append(out, offset);
+    for (std::string_view value : dictionary) {
+        offset += static_cast<uint32_t>(value.size());
+        Append(out, offset);
+    }
+    for (std::string_view value : dictionary) {
+        out.insert(out.end(), value.begin(), value.end());
+    }
+    AppendPadding(out);
+
+    uint8_t codeWidth = static_cast<uint8_t>(width);
+    Append(out, codeWidth);
+    AppendPadding(out);
+
+    size_t start = out.size();
+    out.resize(start + GetBitPackedSize(codes.size(), width));
+    BitPack(codes.data(), codes.size(), width, out.data() + start);
+
+    return Types::Encoding::DICTIONARY;
+}
+
+Bitmap DecodeBitmap(BufferReader& input, size_t rowCount) {
+    std::vector<uint64_t> words(Bitmap::GetWordCount(rowCount));
+    input.Read(words.data(), words.size() * sizeof(uint64_t));
+    return Bitmap(std::move(words), rowCount);
+}
+
+StringVector DecodePlainStrings(BufferReader& input, size_t rowCount) {
+    std::vector<uint32_t> offsets(rowCount + 1);
+    input.Read(offsets.data(), offsets.size() * sizeof(uint32_t));
+
+    std::vector<char> chars(offsets.back());
+    input.Read(chars.data(), chars.size());
+
+    try {
+        return StringVector(std::move(offsets), std::move(chars));
+    } catch (const std::invalid_argument&) {
+        throw std::runtime_error("Corrupted string offsets");
+    }
+}
+
+DictionaryColumn DecodeDictionary(BufferReader& input, size_t rowCount) {
+    DictionaryColumn result;
+
+    uint32_t entryCount;
+    input.Read(&entryCount, sizeof(entryCount));
+    input.SkipPadding(8);
+
+    result.dictionary = DecodePlainStrings(input, entryCount);
+    input.SkipPadding(8);
+
+    uint8_t width;
+    input.Read(&width, sizeof(width));
+    input.SkipPadding(8);
+
+    if (width > 32) {
+        throw std::runtime_error("Invalid dictionary code width");
+    }
+
+    result.codes.resize(rowCount);
+    const char* packed = input.ReadBytes(GetBitPackedSize(rowCount, width));
+    BitUnpack(packed, rowCount, width, 0, result.codes.data());
+
+    for (uint32_t code : result.codes) {
+        if (code >= entryCount) {
+            throw std::runtime_error("Dictionary code out of range");
+        }
+    }
+
+    return result;
+}
+
+#define INSTANTIATE_INTEGER_CODEC(T)                                      \
+    template void BitUnpack<T>(const char*, size_t, size_t, uint64_t, T*); \
+    template Types::Encoding EncodeIntegers<T>(std::span<const T>,        \
+                                               std::vector<char>&);       \
+    template void DecodeIntegers<T>(Types::Encoding, BufferReader&,       \
+                                    std::span<T>);
+
+INSTANTIATE_INTEGER_CODEC(int16_t)
+INSTANTIATE_INTEGER_CODEC(int32_t)
+INSTANTIATE_INTEGER_CODEC(int64_t)
+
+#undef INSTANTIATE_INTEGER_CODEC
+
+template void BitUnpack<uint32_t>(const char*, size_t, size_t, uint64_t,
+                                  uint32_t*);
+template void BitUnpack<uint64_t>(const char*, size_t, size_t, uint64_t,
+                                  uint64_t*);
+
+}  // namespace Columnar::IO
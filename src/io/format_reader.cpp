@@ -1,16 +1,146 @@
 #include <core/types.h>
 
 #include <io/binary_io.h>
+#include <io/encoding.h>
 #include <io/format_reader.h>
+#include <parser/value_parser.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <stdexcept>
 #include "core/row_group.h"
 
 namespace Columnar::IO {
 
-FormatReader::FormatReader(const std::string& filename)
-    : reader_(filename) {}
+namespace {
+
+// chunks closer than this are fetched with one read
+constexpr uint64_t kCoalesceGap = 4096;
+
+TStatistics::TMinMax ReadMinMax(BufferReader& input) {
+    uint8_t tag;
+    input.Read(&tag, sizeof(tag));
+
+    switch (tag) {
+        case 0:
+            return std::monostate{};
+        case 1: {
+            int16_t v;
+            input.Read(&v, sizeof(v));
+            return v;
+        }
+        case 2: {
+            int32_t v;
+            input.Read(&v, sizeof(v));
+            return v;
+        }
+        case 3: {
+            int64_t v;
+            input.Read(&v, sizeof(v));
+            return v;
+        }
+        case 4: {
+            uint8_t byte;
+            input.Read(&byte, sizeof(byte));
+            return byte != 0;
+        }
+        case 5:
+            return input.ReadString();
+        default:
+            throw std::runtime_error("Invalid statistics value tag");
+    }
+}
+
+bool IsCompatible(Types::DataType type, const TStatistics::TMinMax& value) {
+    switch (Types::GetVariantIndex(type)) {
+        case 0:
+        case 1:
+        case 2:
+            return std::holds_alternative<int16_t>(value) ||
+                   std::holds_alternative<int32_t>(value) ||
+                   std::holds_alternative<int64_t>(value);
+        case 3:
+            return std::holds_alternative<bool>(value);
+        case 4:
+            return std::holds_alternative<std::string>(value);
+        default:
+            return false;
+    }
+}
+
+template <typename T>
+std::vector<T> DecodeFixed(BufferReader& input, Types::Encoding encoding,
+                           size_t rowCount) {
+    std::vector<T> vec(rowCount);
+    DecodeIntegers(encoding, input, std::span<T>(vec));
+    return vec;
+}
+
+// Chunks with NULLs start with the validity words
+std::optional<Bitmap> DecodeValidity(BufferReader& input,
+                                     const ColumnChunkMeta& chunk,
+                                     size_t rowCount) {
+    if (chunk.statistics.nullCount == 0) {
+        return std::nullopt;
+    }
+    return DecodeBitmap(input, rowCount);
+}
+
+Column DecodeColumn(BufferReader& input, const std::string& name,
+                    Types::DataType type, const ColumnChunkMeta& chunk,
+                    size_t rowCount) {
+    Types::AnyColumnData data;
+    Types::Encoding encoding = chunk.encoding;
+    std::optional<Bitmap> validity = DecodeValidity(input, chunk, rowCount);
+
+    if (type == Types::DataType::STRING &&
+        encoding == Types::Encoding::DICTIONARY) {
+        DictionaryColumn dictionary = DecodeDictionary(input, rowCount);
+        dictionary.name = name;
+        dictionary.validity = std::move(validity);
+        return dictionary.Materialize();
+    }
+
+    if (Types::GetVariantIndex(type) > 2 &&
+        encoding != Types::Encoding::PLAIN) {
+        throw std::runtime_error("Unsupported encoding for column " + name);
+    }
+
+    switch (type) {
+        case Types::DataType::INT16:
+            data = DecodeFixed<int16_t>(input, encoding, rowCount);
+            break;
+        case Types::DataType::INT32:
+        case Types::DataType::DATE:
+            data = DecodeFixed<int32_t>(input, encoding, rowCount);
+            break;
+        case Types::DataType::INT64:
+        case Types::DataType::INT128:
+        case Types::DataType::TIMESTAMP:
+            data = DecodeFixed<int64_t>(input, encoding, rowCount);
+            break;
+        case Types::DataType::BOOL:
+            data = DecodeBitmap(input, rowCount);
+            break;
+        case Types::DataType::STRING:
+            data = DecodePlainStrings(input, rowCount);
+            break;
+        default:
+            throw std::runtime_error("Unknown data type");
+    }
+
+    Column column(name, type, std::move(data));
+    column.SetValidity(std::move(validity));
+    return column;
+}
+
+}  // namespace
+
+FormatReader::FormatReader(const std::string& filename,
+                           FormatReaderOptions options)
+    : filename_(filename),
+      options_(options),
+      reader_(filename) {}
 
 void FormatReader::Open() {
     if (opened_) {
@@ -22,6 +152,18 @@ void FormatReader::Open() {
     ReadSchema();
     ReadFooter();
 
+    if (options_.useMmap) {
+        mapping_ = std::make_shared<const MappedFile>(filename_);
+    } else if (options_.useIoUring) {
+        // io_uring is often disabled in containers, stream reads still work
+        try {
+            uring_ = std::make_unique<UringReader>(filename_,
+                                                   options_.ioQueueDepth);
+        } catch (const std::runtime_error&) {
+            uring_.reset();
+        }
+    }
+
     opened_ = true;
 }
 
@@ -46,9 +188,7 @@ void FormatReader::ValidateMagic() {
 
 void FormatReader::ReadHeader() {
     reader_.Read(&columnCount_, sizeof(columnCount_));
-
-    uint32_t rowGroupCount;
-    reader_.Read(&rowGroupCount, sizeof(rowGroupCount));
+    reader_.Read(&rowGroupCount_, sizeof(rowGroupCount_));
     reader_.Read(&totalRowCount_, sizeof(totalRowCount_));
 
     uint64_t schemaOffset;
@@ -56,7 +196,7 @@ void FormatReader::ReadHeader() {
     reader_.Read(&footerOffset_, sizeof(footerOffset_));
 
     reader_.Seek(kHeaderSize);
-    rowGroupMetas_.reserve(rowGroupCount);
+    rowGroupMetas_.reserve(rowGroupCount_);
 }
 
 void FormatReader::ReadSchema() {
@@ -66,64 +206,216 @@ void FormatReader::ReadSchema() {
         std::string name = reader_.ReadString();
         schema_.AddColumn(name, static_cast<Types::DataType>(type));
     }
+
+    allColumns_.resize(columnCount_);
+    for (size_t i = 0; i < allColumns_.size(); ++i) {
+        allColumns_[i] = i;
+    }
 }
 
 void FormatReader::ReadFooter() {
+    size_t footerEnd = reader_.GetFileSize() - kMagicSize;
+    if (footerOffset_ > footerEnd) {
+        throw std::runtime_error("Footer offset is out of file bounds");
+    }
+
+    std::vector<char> footer(footerEnd - footerOffset_);
     reader_.Seek(footerOffset_);
+    reader_.Read(footer.data(), footer.size());
 
-    size_t footerEnd = reader_.GetFileSize() - kMagicSize;
-    size_t count = (footerEnd - footerOffset_) / RowGroupMeta::kSerializedSize;
+    BufferReader input(footer.data(), footer.size());
 
-    for (size_t i = 0; i < count; ++i) {
+    for (size_t i = 0; i < rowGroupCount_; ++i) {
         RowGroupMeta meta;
-        reader_.Read(&meta.offset, sizeof(meta.offset));
-        reader_.Read(&meta.size, sizeof(meta.size));
-        reader_.Read(&meta.rowCount, sizeof(meta.rowCount));
-        rowGroupMetas_.push_back(meta);
+        input.Read(&meta.offset, sizeof(meta.offset));
+        input.Read(&meta.size, sizeof(meta.size));
+        input.Read(&meta.rowCount, sizeof(meta.rowCount));
+
+        // written without sums, a corrupt footer must not wrap around
+        if (meta.size > footerOffset_ ||
+            meta.offset > footerOffset_ - meta.size) {
+            throw std::runtime_error("Row group " + std::to_string(i) +
+                                     " is out of file bounds");
+        }
+
+        meta.columns.resize(columnCount_);
+        for (auto& chunk : meta.columns) {
+            input.Read(&chunk.offset, sizeof(chunk.offset));
+            input.Read(&chunk.size, sizeof(chunk.size));
+
+            uint8_t encoding;
+            input.Read(&encoding, sizeof(encoding));
+            chunk.encoding = static_cast<Types::Encoding>(encoding);
+
+            uint64_t nullCount;
+            input.Read(&nullCount, sizeof(nullCount));
+            chunk.statistics.rowCount = meta.rowCount;
+            chunk.statistics.nullCount = nullCount;
+            chunk.statistics.min_value = ReadMinMax(input);
+            chunk.statistics.max_value = ReadMinMax(input);
+
+            if (chunk.offset < meta.offset ||
+                chunk.size > meta.offset + meta.size - chunk.offset) {
+                throw std::runtime_error("Column chunk of row group " +
+                                         std::to_string(i) +
+                                         " is out of row group bounds");
+            }
+        }
+
+        rowGroupMetas_.push_back(std::move(meta));
     }
 }
 
 std::optional<Batch> FormatReader::ReadBatch() {
     if (!opened_)
         Open();
+    return ReadBatch(allColumns_);
+}
+
+std::optional<Batch> FormatReader::ReadBatch(
+    const std::vector<size_t>& projection) {
+    if (!opened_)
+        Open();
+    SkipNonMatchingRowGroups();
     if (currentRowGroupIndex_ >= rowGroupMetas_.size())
         return std::nullopt;
 
-    RowGroup rg = ReadRowGroup(currentRowGroupIndex_++);
+    RowGroup rg = ReadRowGroup(currentRowGroupIndex_++, projection);
     return rg.MoveBatch();
 }
 
 bool FormatReader::HasMore() const {
-    return currentRowGroupIndex_ < rowGroupMetas_.size();
+    for (size_t i = currentRowGroupIndex_; i < rowGroupMetas_.size(); ++i) {
+        if (RowGroupMayMatch(i)) {
+            return true;
+        }
+    }
+    return false;
 }
 
-RowGroup FormatReader::ReadRowGroup(size_t index) {
-    if (!opened_)
-        throw std::logic_error("Open() not called");
-    if (index >= rowGroupMetas_.size())
-        throw std::out_of_range("Index out of range");
+RowGroup FormatReader::ReadRowGroup(size_t index) const {
+    return ReadRowGroup(index, allColumns_);
+}
 
-    const auto& meta = rowGroupMetas_[index];
-    reader_.Seek(meta.offset);
+RowGroup FormatReader::ReadRowGroup(
+    size_t index, const std::vector<size_t>& columnIndices) const {
+    const auto& meta = GetCheckedMeta(index);
+    Schema schema = ProjectSchema(columnIndices);
 
-    uint32_t rowCount;
-    reader_.Read(&rowCount, sizeof(rowCount));
+    auto chunks = FetchChunks(meta, columnIndices, nullptr);
+    return DecodeRowGroup(meta, columnIndices, std::move(schema), chunks);
+}
 
-    std::vector<Column> columns;
-    columns.reserve(schema_.GetColumnCount());
+std::vector<RowGroup> FormatReader::ReadRowGroups(
+    const std::vector<size_t>& indices,
+    const std::vector<size_t>& columnIndices) const {
+    Schema schema = ProjectSchema(columnIndices);
 
-    for (const auto& colSchema : schema_) {
-        columns.push_back(ReadColumn(colSchema.name, colSchema.type, rowCount));
+    std::vector<RowGroup> result;
+    result.reserve(indices.size());
+
+    if (mapping_) {
+        for (size_t index : indices) {
+            const auto& meta = GetCheckedMeta(index);
+            auto chunks = FetchChunks(meta, columnIndices, nullptr);
+            result.push_back(
+                DecodeRowGroup(meta, columnIndices, schema, chunks));
+        }
+        return result;
     }
 
-    Batch batch(schema_, std::move(columns));
-    return RowGroup(std::move(batch), meta);
+    // all reads are issued at once, so the io_uring backend can keep many of
+    // them in flight
+    std::vector<std::vector<char>> buffers(indices.size());
+    std::vector<std::vector<std::span<const char>>> chunks(indices.size());
+    std::vector<ReadRequest> reads;
+
+    for (size_t i = 0; i < indices.size(); ++i) {
+        const auto& meta = GetCheckedMeta(indices[i]);
+        chunks[i] = PlanChunkReads(meta, columnIndices, buffers[i], reads);
+    }
+    ExecuteReads(reads);
+
+    for (size_t i = 0; i < indices.size(); ++i) {
+        result.push_back(DecodeRowGroup(rowGroupMetas_[indices[i]],
+                                        columnIndices, schema, chunks[i]));
+    }
+    return result;
+}
+
+BatchView FormatReader::ReadRowGroupView(size_t index) const {
+    return ReadRowGroupView(index, allColumns_);
+}
+
+BatchView FormatReader::ReadRowGroupView(
+    size_t index, const std::vector<size_t>& columnIndices) const {
+    const auto& meta = GetCheckedMeta(index);
+    Schema schema = ProjectSchema(columnIndices);
+
+    std::shared_ptr<const void> owner;
+    auto chunks = FetchChunks(meta, columnIndices, &owner);
+
+    std::vector<ColumnView> columns;
+    columns.reserve(columnIndices.size());
+
+    for (size_t i = 0; i < columnIndices.size(); ++i) {
+        const auto& colSchema = schema.GetColumn(i);
+        const auto& chunk = meta.columns[columnIndices[i]];
+
+        // only plain chunks without NULLs can be viewed in place, the rest
+        // is decoded
+        if (Types::IsFixedSize(colSchema.type) &&
+            colSchema.type != Types::DataType::BOOL &&
+            chunk.encoding == Types::Encoding::PLAIN &&
+            chunk.statistics.nullCount == 0) {
+            size_t byteSize =
+                meta.rowCount * Types::GetTypeSize(colSchema.type);
+            if (chunks[i].size() < byteSize) {
+                throw std::runtime_error("Column chunk is truncated: " +
+                                         colSchema.name);
+            }
+            columns.emplace_back(colSchema.name, colSchema.type,
+                                 chunks[i].data(), meta.rowCount, owner);
+        } else {
+            BufferReader input(chunks[i].data(), chunks[i].size());
+            columns.emplace_back(DecodeColumn(input, colSchema.name,
+                                              colSchema.type, chunk,
+                                              meta.rowCount));
+        }
+    }
+
+    return BatchView(std::move(schema), std::move(columns));
+}
+
+std::optional<DictionaryColumn> FormatReader::ReadDictionaryColumn(
+    size_t index, size_t columnIndex) const {
+    const auto& meta = GetCheckedMeta(index);
+    const auto& colSchema = schema_.GetColumn(columnIndex);
+
+    const auto& chunk = meta.columns[columnIndex];
+    if (chunk.encoding != Types::Encoding::DICTIONARY) {
+        return std::nullopt;
+    }
+
+    auto chunks = FetchChunks(meta, {columnIndex}, nullptr);
+    BufferReader input(chunks[0].data(), chunks[0].size());
+
+    std::optional<Bitmap> validity =
+        DecodeValidity(input, chunk, meta.rowCount);
+    DictionaryColumn dictionary = DecodeDictionary(input, meta.rowCount);
+    dictionary.name = colSchema.name;
+    dictionary.validity = std::move(validity);
+    return dictionary;
 }
 
 const Schema& FormatReader::GetSchema() const {
     return schema_;
 }
 
+bool FormatReader::UsesIoUring() const {
+    return uring_ != nullptr;
+}
+
 size_t FormatReader::GetRowGroupCount() const {
     return rowGroupMetas_.size();
 }
@@ -132,72 +424,228 @@ uint64_t FormatReader::GetTotalRowCount() const {
     return totalRowCount_;
 }
 
-Column FormatReader::ReadColumn(const std::string& name, Types::DataType type,
-                                size_t rowCount) {
-    Types::AnyColumnData data;
+std::vector<size_t> FormatReader::GetColumnIndices(
+    const std::vector<std::string>& names) const {
+    std::vector<size_t> indices;
+    indices.reserve(names.size());
 
-    switch (type) {
-        case Types::DataType::INT16: {
-            std::vector<int16_t> vec;
-            vec.reserve(rowCount);
-            for (size_t i = 0; i < rowCount; ++i) {
-                int16_t v;
-                reader_.Read(&v, sizeof(v));
-                vec.push_back(v);
-            }
-            data = std::move(vec);
-            break;
+    for (const auto& name : names) {
+        auto idx = schema_.FindColumn(name);
+        if (!idx) {
+            throw std::invalid_argument("Unknown column: " + name);
         }
-        case Types::DataType::INT32:
-        case Types::DataType::DATE: {
-            std::vector<int32_t> vec;
-            vec.reserve(rowCount);
-            for (size_t i = 0; i < rowCount; ++i) {
-                int32_t v;
-                reader_.Read(&v, sizeof(v));
-                vec.push_back(v);
-            }
-            data = std::move(vec);
-            break;
+        indices.push_back(*idx);
+    }
+
+    return indices;
+}
+
+void FormatReader::SetPredicates(std::vector<TPredicate> predicates) {
+    if (!opened_)
+        Open();
+
+    std::vector<size_t> columns;
+    columns.reserve(predicates.size());
+
+    for (const auto& predicate : predicates) {
+        auto idx = schema_.FindColumn(predicate.column);
+        if (!idx) {
+            throw std::invalid_argument("Unknown predicate column: " +
+                                        predicate.column);
         }
-        case Types::DataType::INT64:
-        case Types::DataType::INT128:
-        case Types::DataType::TIMESTAMP: {
-            std::vector<int64_t> vec;
-            vec.reserve(rowCount);
-            for (size_t i = 0; i < rowCount; ++i) {
-                int64_t v;
-                reader_.Read(&v, sizeof(v));
-                vec.push_back(v);
-            }
-            data = std::move(vec);
-            break;
+        if (!IsCompatible(schema_.GetColumn(*idx).type, predicate.value)) {
+            throw std::invalid_argument(
+                "Predicate constant type does not match column " +
+                predicate.column);
         }
-        case Types::DataType::BOOL: {
-            std::vector<bool> vec;
-            vec.reserve(rowCount);
-            for (size_t i = 0; i < rowCount; ++i) {
-                uint8_t byte;
-                reader_.Read(&byte, sizeof(byte));
-                vec.push_back(byte != 0);
-            }
-            data = std::move(vec);
-            break;
+        columns.push_back(*idx);
+    }
+
+    predicates_ = std::move(predicates);
+    predicateColumns_ = std::move(columns);
+}
+
+void FormatReader::AddPredicate(const std::string& column,
+                                TStatistics::ECompareOp op,
+                                const std::string& literal) {
+    if (!opened_)
+        Open();
+
+    auto idx = schema_.FindColumn(column);
+    if (!idx) {
+        throw std::invalid_argument("Unknown predicate column: " + column);
+    }
+
+    auto parsed = Parser::ParseValue(literal, schema_.GetColumn(*idx).type);
+    TStatistics::TMinMax value = std::visit(
+        [](auto&& v) -> TStatistics::TMinMax { return std::move(v); },
+        std::move(parsed));
+
+    auto predicates = predicates_;
+    predicates.push_back({column, op, std::move(value)});
+    SetPredicates(std::move(predicates));
+}
+
+bool FormatReader::RowGroupMayMatch(size_t index) const {
+    const auto& meta = GetCheckedMeta(index);
+
+    for (size_t i = 0; i < predicates_.size(); ++i) {
+        const auto& stats = meta.columns[predicateColumns_[i]].statistics;
+        if (!stats.MayMatch(predicates_[i].op, predicates_[i].value)) {
+            return false;
         }
-        case Types::DataType::STRING: {
-            std::vector<std::string> vec;
-            vec.reserve(rowCount);
-            for (size_t i = 0; i < rowCount; ++i) {
-                vec.push_back(reader_.ReadString());
-            }
-            data = std::move(vec);
-            break;
+    }
+
+    return true;
+}
+
+void FormatReader::SkipNonMatchingRowGroups() {
+    while (currentRowGroupIndex_ < rowGroupMetas_.size() &&
+           !RowGroupMayMatch(currentRowGroupIndex_)) {
+        ++currentRowGroupIndex_;
+    }
+}
+
+RowGroup FormatReader::DecodeRowGroup(
+    const RowGroupMeta& meta, const std::vector<size_t>& columnIndices,
+    Schema schema, const std::vector<std::span<const char>>& chunks) const {
+    std::vector<Column> columns;
+    columns.reserve(columnIndices.size());
+
+    for (size_t i = 0; i < columnIndices.size(); ++i) {
+        const auto& colSchema = schema.GetColumn(i);
+        BufferReader input(chunks[i].data(), chunks[i].size());
+        columns.push_back(DecodeColumn(input, colSchema.name, colSchema.type,
+                                       meta.columns[columnIndices[i]],
+                                       meta.rowCount));
+    }
+
+    Batch batch(std::move(schema), std::move(columns));
+    return RowGroup(std::move(batch), meta);
+}
+
+const RowGroupMeta& FormatReader::GetCheckedMeta(size_t index) const {
+    if (!opened_)
+        throw std::logic_error("Open() not called");
+    if (index >= rowGroupMetas_.size())
+        throw std::out_of_range("Index out of range");
+    return rowGroupMetas_[index];
+}
+
+Schema FormatReader::ProjectSchema(
+    const std::vector<size_t>& columnIndices) const {
+    Schema schema;
+    for (size_t index : columnIndices) {
+        schema.AddColumn(schema_.GetColumn(index));
+    }
+    return schema;
+}
+
+std::vector<std::span<const char>> FormatReader::FetchChunks(
+    const RowGroupMeta& meta, const std::vector<size_t>& columnIndices,
+    std::shared_ptr<const void>* owner) const {
+    if (mapping_) {
+        std::vector<std::span<const char>> chunks(columnIndices.size());
+        for (size_t i = 0; i < columnIndices.size(); ++i) {
+            const auto& chunk = meta.columns[columnIndices[i]];
+            chunks[i] = {mapping_->GetData() + chunk.offset, chunk.size};
         }
-        default:
-            throw std::runtime_error("Unknown data type");
+
+        if (owner) {
+            *owner = mapping_;
+        }
+        return chunks;
+    }
+
+    // reused between reads of one thread, concurrent readers do not share it
+    thread_local std::vector<char> threadBuffer;
+
+    std::vector<char>* buffer = &threadBuffer;
+    std::shared_ptr<std::vector<char>> block;
+    if (owner) {
+        block = std::make_shared<std::vector<char>>();
+        buffer = block.get();
+        *owner = block;
+    }
+
+    std::vector<ReadRequest> reads;
+    auto chunks = PlanChunkReads(meta, columnIndices, *buffer, reads);
+    ExecuteReads(reads);
+    return chunks;
+}
+
+std::vector<std::span<const char>> FormatReader::PlanChunkReads(
+    const RowGroupMeta& meta, const std::vector<size_t>& columnIndices,
+    std::vector<char>& buffer, std::vector<ReadRequest>& reads) const {
+    // Requested chunks are coalesced into ranges so that neighbouring columns
+    // (or a whole row group) are fetched with a single read
+    struct Range {
+        uint64_t fileOffset = 0;
+        uint64_t fileEnd = 0;
+        size_t bufferOffset = 0;
+    };
+
+    std::vector<size_t> order(columnIndices.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        return meta.columns[columnIndices[lhs]].offset <
+               meta.columns[columnIndices[rhs]].offset;
+    });
+
+    std::vector<Range> ranges;
+    std::vector<size_t> chunkRange(columnIndices.size());
+
+    for (size_t i : order) {
+        const auto& chunk = meta.columns[columnIndices[i]];
+        uint64_t chunkEnd = chunk.offset + chunk.size;
+
+        if (ranges.empty() ||
+            chunk.offset > ranges.back().fileEnd + kCoalesceGap) {
+            ranges.push_back({chunk.offset, chunkEnd, 0});
+        } else {
+            ranges.back().fileEnd = std::max(ranges.back().fileEnd, chunkEnd);
+        }
+        chunkRange[i] = ranges.size() - 1;
+    }
+
+    // ranges keep their file alignment inside the buffer
+    size_t totalSize = 0;
+    for (auto& range : ranges) {
+        range.bufferOffset = totalSize;
+        totalSize += range.fileEnd - range.fileOffset;
+        totalSize = (totalSize + kChunkAlignment - 1) / kChunkAlignment *
+                    kChunkAlignment;
+    }
+    buffer.resize(totalSize);
+
+    for (const auto& range : ranges) {
+        reads.push_back({range.fileOffset, range.fileEnd - range.fileOffset,
+                         buffer.data() + range.bufferOffset});
     }
 
-    return Column(name, type, std::move(data));
+    std::vector<std::span<const char>> chunks(columnIndices.size());
+    for (size_t i = 0; i < columnIndices.size(); ++i) {
+        const auto& chunk = meta.columns[columnIndices[i]];
+        const auto& range = ranges[chunkRange[i]];
+        chunks[i] = {buffer.data() + range.bufferOffset +
+                         (chunk.offset - range.fileOffset),
+                     chunk.size};
+    }
+
+    return chunks;
+}
+
+void FormatReader::ExecuteReads(const std::vector<ReadRequest>& reads) const {
+    if (uring_) {
+        uring_->Read(reads);
+        return;
+    }
+
+    for (const auto& read : reads) {
+        reader_.ReadAt(read.offset, read.destination, read.size);
+    }
 }
 
 const RowGroupMeta& FormatReader::GetRowGroupMeta(size_t index) const {
@@ -206,4 +654,4 @@ const RowGroupMeta& FormatReader::GetRowGroupMeta(size_t index) const {
     return rowGroupMetas_[index];
 }
 
-}  // namespace Columnar::IO
\ No newline at end of file
+}  // namespace Columnar::IO
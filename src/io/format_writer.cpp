@@ -1,3 +1,4 @@
+#include <io/encoding.h>
 #include <io/format_writer.h>
 #include <cstdint>
 #include <stdexcept>
@@ -8,8 +9,90 @@
 
 namespace Columnar::IO {
 
-FormatWriter::FormatWriter(const std::string& filename)
-    : writer_(filename) {}
+namespace {
+
+void WriteMinMax(BinaryWriter& writer, const TStatistics::TMinMax& value) {
+    uint8_t tag = static_cast<uint8_t>(value.index());
+    writer.Write(&tag, sizeof(tag));
+
+    std::visit(Types::overloaded{[](std::monostate) {},
+                                 [&writer](bool v) {
+                                     uint8_t byte = v ? 1 : 0;
+                                     writer.Write(&byte, sizeof(byte));
+                                 },
+                                 [&writer](const std::string& v) {
+                                     writer.WriteString(v);
+                                 },
+                                 [&writer](const auto& v) {
+                                     writer.Write(&v, sizeof(v));
+                                 }},
+               value);
+}
+
+template <typename T>
+void AppendRaw(std::vector<char>& out, const T* data, size_t count) {
+    const char* bytes = reinterpret_cast<const char*>(data);
+    out.insert(out.end(), bytes, bytes + count * sizeof(T));
+}
+
+void PadTo(std::vector<char>& out, size_t alignment) {
+    out.resize((out.size() + alignment - 1) / alignment * alignment);
+}
+
+// Appends the chunk bytes; `out` must be aligned like the chunk in the file
+// because encoded layouts pad relative to the chunk start. Columns with NULLs
+// start with their validity words, which keep that alignment. The reader
+// expects them only if the chunk's nullCount is non-zero, so an all-set
+// validity bitmap is not written.
+Types::Encoding EncodeColumn(const Column& column, std::vector<char>& out) {
+    if (column.GetNullCount() > 0) {
+        auto words = column.GetValidity()->GetWords();
+        AppendRaw(out, words.data(), words.size());
+    }
+
+    auto encodeIntegers = [&out](const auto& vec) {
+        Types::Encoding encoding =
+            EncodeIntegers(std::span(vec.data(), vec.size()), out);
+
+        if (encoding == Types::Encoding::PLAIN) {
+            AppendRaw(out, vec.data(), vec.size());
+        }
+        return encoding;
+    };
+
+    return std::visit(
+        Types::overloaded{encodeIntegers,
+                          [&out](const Bitmap& vec) {
+                              auto words = vec.GetWords();
+                              AppendRaw(out, words.data(), words.size());
+                              return Types::Encoding::PLAIN;
+                          },
+                          [&out](const StringVector& vec) {
+                              Types::Encoding encoding =
+                                  EncodeStrings(vec, out);
+
+                              if (encoding == Types::Encoding::PLAIN) {
+                                  auto offsets = vec.GetOffsets();
+                                  auto chars = vec.GetChars();
+                                  AppendRaw(out, offsets.data(),
+                                            offsets.size());
+                                  AppendRaw(out, chars.data(), chars.size());
+                              }
+                              return encoding;
+                          }},
+        column.GetData());
+}
+
+}  // namespace
+
+FormatWriter::FormatWriter(const std::string& filename,
+                           FormatWriterOptions options)
+    : writer_(filename),
+      options_(options) {
+    if (options_.encodeThreads > 0) {
+        pool_ = std::make_unique<ThreadPool>(options_.encodeThreads);
+    }
+}
 
 FormatWriter::~FormatWriter() {
     if (begun_ && !ended_) {
@@ -32,30 +115,96 @@ void FormatWriter::Begin(const Schema& schema) {
 }
 
 void FormatWriter::WriteRowGroup(const RowGroup& rowGroup) {
+    CheckWritable();
+
+    if (!pool_) {
+        AppendRowGroup(EncodeRowGroup(rowGroup.GetBatch()));
+        return;
+    }
+
+    // the caller keeps its batch, the worker gets a copy
+    WriteRowGroup(RowGroup(rowGroup.GetBatch().GetCompacted()));
+}
+
+void FormatWriter::WriteRowGroup(RowGroup&& rowGroup) {
+    CheckWritable();
+
+    if (!pool_) {
+        AppendRowGroup(EncodeRowGroup(rowGroup.GetBatch()));
+        return;
+    }
+
+    auto batch = std::make_shared<Batch>(rowGroup.MoveBatch());
+    pending_.push_back(
+        pool_->Submit([batch] { return EncodeRowGroup(*batch); }));
+    WritePending(options_.maxInFlight);
+}
+
+void FormatWriter::CheckWritable() const {
     if (!begun_) {
         throw std::logic_error("FormatWriter::Begin() not called");
     }
     if (ended_) {
         throw std::logic_error("FormatWriter::End() already called");
     }
+}
 
-    const Batch& batch = rowGroup.GetBatch();
+FormatWriter::EncodedRowGroup FormatWriter::EncodeRowGroup(const Batch& batch) {
+    // only selected rows are stored
+    if (batch.HasSelection()) {
+        return EncodeRowGroup(batch.GetCompacted());
+    }
 
-    RowGroupMeta meta;
-    meta.offset = writer_.GetPosition();
+    EncodedRowGroup encoded;
+    encoded.rowCount = static_cast<uint32_t>(batch.GetRowCount());
+    encoded.columns.reserve(batch.GetColumnCount());
 
-    uint32_t rowCount = static_cast<uint32_t>(batch.GetRowCount());
-    writer_.Write(&rowCount, sizeof(rowCount));
+    auto& data = encoded.data;
+    AppendRaw(data, &encoded.rowCount, 1);
 
     for (size_t i = 0; i < batch.GetColumnCount(); ++i) {
-        WriteColumn(batch.GetColumn(i));
+        const Column& column = batch.GetColumn(i);
+        PadTo(data, kChunkAlignment);
+
+        ColumnChunkMeta chunk;
+        chunk.offset = data.size();
+        chunk.encoding = EncodeColumn(column, data);
+        chunk.size = data.size() - chunk.offset;
+        chunk.statistics = TStatistics::Compute(column);
+
+        encoded.columns.push_back(std::move(chunk));
     }
 
-    meta.size = writer_.GetPosition() - meta.offset;
-    meta.rowCount = rowCount;
+    return encoded;
+}
+
+void FormatWriter::AppendRowGroup(EncodedRowGroup encoded) {
+    // aligned chunks let readers view mapped data in place
+    writer_.WritePadding(kChunkAlignment);
+
+    RowGroupMeta meta;
+    meta.offset = writer_.GetPosition();
+    meta.size = encoded.data.size();
+    meta.rowCount = encoded.rowCount;
+    meta.columns = std::move(encoded.columns);
+    for (auto& chunk : meta.columns) {
+        chunk.offset += meta.offset;
+    }
+
+    writer_.Write(encoded.data.data(), encoded.data.size());
+
+    rowGroupMetas_.push_back(std::move(meta));
+    totalRowCount_ += encoded.rowCount;
+}
 
-    rowGroupMetas_.push_back(meta);
-    totalRowCount_ += rowCount;
+// Writes finished row groups in submission order until at most `keep` are
+// pending
+void FormatWriter::WritePending(size_t keep) {
+    while (pending_.size() > keep) {
+        EncodedRowGroup encoded = pending_.front().get();
+        pending_.pop_front();
+        AppendRowGroup(std::move(encoded));
+    }
 }
 
 void FormatWriter::End() {
@@ -66,6 +215,7 @@ void FormatWriter::End() {
         throw std::logic_error("FormatWriter::End() already called");
     }
 
+    WritePending(0);
     WriteFooter();
     writer_.Write(kMagicBytes, kMagicSize);
     FinalizeHeader();
@@ -106,50 +256,31 @@ void FormatWriter::WriteSchema() {
     }
 }
 
-void FormatWriter::WriteColumn(const Column& column) {
-    const auto& data = column.GetData();
-
-    std::visit(Types::overloaded{[this](const std::vector<int16_t>& vec) {
-                                     for (int16_t v : vec) {
-                                         writer_.Write(&v, sizeof(v));
-                                     }
-                                 },
-                                 [this](const std::vector<int32_t>& vec) {
-                                     for (int32_t v : vec) {
-                                         writer_.Write(&v, sizeof(v));
-                                     }
-                                 },
-                                 [this](const std::vector<int64_t>& vec) {
-                                     for (int64_t v : vec) {
-                                         writer_.Write(&v, sizeof(v));
-                                     }
-                                 },
-                                 [this](const std::vector<bool>& vec) {
-                                     for (bool v : vec) {
-                                         uint8_t byte = v ? 1 : 0;
-                                         writer_.Write(&byte, sizeof(byte));
-                                     }
-                                 },
-                                 [this](const std::vector<std::string>& vec) {
-                                     for (const auto& s : vec) {
-                                         writer_.WriteString(s);
-                                     }
-                                 }},
-               data);
-}
-
 void FormatWriter::WriteFooter() {
+    footerOffset_ = writer_.GetPosition();
+
     for (const auto& meta : rowGroupMetas_) {
         writer_.Write(&meta.offset, sizeof(meta.offset));
         writer_.Write(&meta.size, sizeof(meta.size));
         writer_.Write(&meta.rowCount, sizeof(meta.rowCount));
+
+        for (const auto& chunk : meta.columns) {
+            writer_.Write(&chunk.offset, sizeof(chunk.offset));
+            writer_.Write(&chunk.size, sizeof(chunk.size));
+
+            uint8_t encoding = static_cast<uint8_t>(chunk.encoding);
+            writer_.Write(&encoding, sizeof(encoding));
+
+            uint64_t nullCount = chunk.statistics.nullCount;
+            writer_.Write(&nullCount, sizeof(nullCount));
+            WriteMinMax(writer_, chunk.statistics.min_value);
+            WriteMinMax(writer_, chunk.statistics.max_value);
+        }
     }
 }
 
 void FormatWriter::FinalizeHeader() {
     size_t currentPos = writer_.GetPosition();
-    size_t footerSize = rowGroupMetas_.size() * RowGroupMeta::kSerializedSize;
-    uint64_t footerOffset = currentPos - kMagicSize - footerSize;
 
     writer_.Seek(4);
     uint32_t rowGroupCount = static_cast<uint32_t>(rowGroupMetas_.size());
@@ -157,7 +288,7 @@ void FormatWriter::FinalizeHeader() {
     writer_.Write(&totalRowCount_, sizeof(totalRowCount_));
 
     writer_.Seek(24);
-    writer_.Write(&footerOffset, sizeof(footerOffset));
+    writer_.Write(&footerOffset_, sizeof(footerOffset_));
 
     writer_.Seek(currentPos);
 }
@@ -0,0 +1,244 @@
+#include <io/parallel_csv_reader.h>
+#include <parser/csv_column_parser.h>
+#include <parser/csv_tokenizer.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Columnar::IO {
+
+ParallelCsvReader::ParallelCsvReader(const std::string& filename,
+                                     const Schema& schema,
+                                     ParallelCsvOptions options)
+    : file_(filename),
+      data_(file_.GetData(), file_.GetSize()),
+      schema_(schema),
+      options_(std::move(options)) {
+    if (schema_.IsEmpty()) {
+        throw std::invalid_argument("Schema cannot be empty");
+    }
+    if (options_.chunkSize == 0) {
+        throw std::invalid_argument("CSV chunk size must be positive");
+    }
+
+    rangeCount_ = data_.empty() ? 0 : data_.size() / options_.chunkSize + 1;
+    startParity_.emplace(0, false);
+
+    pool_ = std::make_unique<ThreadPool>(options_.threads);
+    if (options_.maxInFlight == 0) {
+        options_.maxInFlight = 2 * pool_->GetThreadCount();
+    }
+}
+
+ParallelCsvReader::~ParallelCsvReader() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    parityReady_.notify_all();
+    pool_.reset();
+}
+
+std::optional<Batch> ParallelCsvReader::ReadBatch() {
+    while (ready_.empty()) {
+        SubmitRanges();
+        if (!TakeResult()) {
+            return std::nullopt;
+        }
+    }
+
+    Batch batch = std::move(ready_.front());
+    ready_.pop_front();
+    totalRowsRead_ += batch.GetRowCount();
+    return batch;
+}
+
+const Schema& ParallelCsvReader::GetSchema() const {
+    return schema_;
+}
+
+size_t ParallelCsvReader::GetTotalRowsRead() const {
+    return totalRowsRead_;
+}
+
+void ParallelCsvReader::SubmitRanges() {
+    // tasks wait for the parity of their predecessors, which the FIFO pool
+    // always starts first
+    while (inFlight_ < options_.maxInFlight && submitted_ < rangeCount_) {
+        size_t index = submitted_++;
+        ++inFlight_;
+
+        pool_->Submit([this, index] {
+            auto range = FindRange(index);
+            if (!range) {
+                return;
+            }
+
+            TRangeResult result;
+            try {
+                result.batches = ParseRange(range->first, range->second);
+            } catch (...) {
+                result.error = std::current_exception();
+            }
+
+            {
+                std::lock_guard lock(mutex_);
+                results_.emplace(index, std::move(result));
+            }
+            completed_.notify_one();
+        });
+    }
+}
+
+// Nominal chunk `index` starts here. A range starts at the first record
+// start at or after its cut.
+size_t ParallelCsvReader::GetCut(size_t index) const {
+    if (index == 0) {
+        return 0;
+    }
+    return std::min(index * options_.chunkSize - 1, data_.size());
+}
+
+// Record-aligned byte range of chunk `index`, nullopt if the reader is
+// being destroyed. The quotes of the chunk are counted before waiting for
+// the parity at its start.
+std::optional<std::pair<size_t, size_t>> ParallelCsvReader::FindRange(
+    size_t index) {
+    size_t cut = GetCut(index);
+    size_t nextCut = GetCut(index + 1);
+    bool oddQuotes = std::count(data_.begin() + cut, data_.begin() + nextCut,
+                                options_.csv.quote) %
+                         2 !=
+                     0;
+
+    bool inQuotes;
+    {
+        std::unique_lock lock(mutex_);
+        parityReady_.wait(lock, [this, index] {
+            return stopping_ || startParity_.contains(index);
+        });
+        if (stopping_) {
+            return std::nullopt;
+        }
+
+        auto it = startParity_.find(index);
+        inQuotes = it->second;
+        startParity_.erase(it);
+        startParity_.emplace(index + 1, inQuotes != oddQuotes);
+    }
+    parityReady_.notify_all();
+
+    size_t begin = index == 0 ? 0
+                              : Parser::FindRecordStart(data_, cut, inQuotes,
+                                                        options_.csv);
+    size_t end = index + 1 == rangeCount_
+                     ? data_.size()
+                     : Parser::FindRecordStart(data_, nextCut,
+                                               inQuotes != oddQuotes,
+                                               options_.csv);
+    return std::make_pair(begin, std::max(begin, end));
+}
+
+// Moves the batches of one finished range into ready_, false if all ranges
+// were already taken
+bool ParallelCsvReader::TakeResult() {
+    if (inFlight_ == 0) {
+        return false;
+    }
+
+    std::unique_lock lock(mutex_);
+    completed_.wait(lock, [this] {
+        return options_.ordered ? results_.contains(nextToReturn_)
+                                : !results_.empty();
+    });
+
+    auto it = options_.ordered ? results_.find(nextToReturn_)
+                               : results_.begin();
+    TRangeResult result = std::move(it->second);
+    results_.erase(it);
+    lock.unlock();
+
+    --inFlight_;
+    ++nextToReturn_;
+
+    if (result.error) {
+        std::rethrow_exception(result.error);
+    }
+    for (auto& batch : result.batches) {
+        ready_.push_back(std::move(batch));
+    }
+    return true;
+}
+
+std::vector<Batch> ParallelCsvReader::ParseRange(size_t begin,
+                                                 size_t end) const {
+    std::string_view range = data_.substr(begin, end - begin);
+
+    Parser::CsvTokens tokens;
+    try {
+        Parser::TokenizeCsv(range, tokens, options_.csv);
+    } catch (const std::exception& e) {
+        throw std::runtime_error("CSV range at byte " + std::to_string(begin) +
+                                 ": " + e.what());
+    }
+
+    std::vector<Batch> batches;
+    std::vector<uint32_t> records;  // first field of each batch record
+    records.reserve(kBatchSize);
+
+    auto flush = [&] {
+        std::vector<Column> columns;
+        columns.reserve(schema_.GetColumnCount());
+        for (size_t c = 0; c < schema_.GetColumnCount(); ++c) {
+            const auto& colSchema = schema_.GetColumn(c);
+            columns.emplace_back(colSchema.name, colSchema.type);
+            try {
+                Parser::AppendCsvColumn(range, tokens, records, c,
+                                        columns.back(), options_.csv);
+            } catch (const std::exception& e) {
+                throw std::runtime_error("CSV range at byte " +
+                                         std::to_string(begin) + ", column " +
+                                         colSchema.name + ": " + e.what());
+            }
+        }
+        batches.emplace_back(schema_, std::move(columns));
+        records.clear();
+    };
+
+    size_t field = 0;
+    for (uint32_t recordEnd : tokens.recordEnds) {
+        size_t recordStart = tokens.GetFieldBegin(field);
+        size_t fieldCount = recordEnd - field;
+
+        // empty lines are skipped like in CsvReader
+        if (fieldCount == 1) {
+            size_t length = tokens.fieldEnds[field] - recordStart;
+            if (length == 0 || (length == 1 && range[recordStart] == '\r')) {
+                field = recordEnd;
+                continue;
+            }
+        }
+
+        if (fieldCount != schema_.GetColumnCount()) {
+            throw std::runtime_error(
+                "CSV record at byte " + std::to_string(begin + recordStart) +
+                ": field count mismatch: expected " +
+                std::to_string(schema_.GetColumnCount()) + ", got " +
+                std::to_string(fieldCount));
+        }
+
+        records.push_back(static_cast<uint32_t>(field));
+        field = recordEnd;
+
+        if (records.size() == kBatchSize) {
+            flush();
+        }
+    }
+
+    if (!records.empty()) {
+        flush();
+    }
+    return batches;
+}
+
+}  // namespace Columnar::IO
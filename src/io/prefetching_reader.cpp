@@ -0,0 +1,123 @@
+#include <io/prefetching_reader.h>
+
+#include <numeric>
+#include <stdexcept>
+
+namespace Columnar::IO {
+
+PrefetchingReader::PrefetchingReader(FormatReader reader,
+                                     PrefetchOptions options)
+    : reader_(std::move(reader)),
+      options_(std::move(options)) {
+    if (options_.depth == 0) {
+        throw std::invalid_argument("Prefetch depth must be positive");
+    }
+
+    reader_.Open();
+    if (options_.projection.empty()) {
+        options_.projection.resize(reader_.GetSchema().GetColumnCount());
+        std::iota(options_.projection.begin(), options_.projection.end(), 0);
+    }
+
+    for (size_t index : options_.projection) {
+        schema_.AddColumn(reader_.GetSchema().GetColumn(index));
+    }
+
+    worker_ = std::thread([this] { Run(); });
+}
+
+PrefetchingReader::~PrefetchingReader() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    consumed_.notify_all();
+    worker_.join();
+}
+
+std::optional<RowGroup> PrefetchingReader::ReadRowGroup() {
+    std::unique_lock lock(mutex_);
+    produced_.wait(lock, [this] {
+        return !queue_.empty() || finished_ || error_;
+    });
+
+    if (queue_.empty()) {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+        return std::nullopt;
+    }
+
+    TQueued item = std::move(queue_.front());
+    queue_.pop_front();
+    queuedBytes_ -= item.bytes;
+    lock.unlock();
+
+    consumed_.notify_one();
+    return std::move(item.rowGroup);
+}
+
+std::optional<Batch> PrefetchingReader::ReadBatch() {
+    auto rowGroup = ReadRowGroup();
+    if (!rowGroup) {
+        return std::nullopt;
+    }
+    return rowGroup->MoveBatch();
+}
+
+const Schema& PrefetchingReader::GetSchema() const {
+    return schema_;
+}
+
+void PrefetchingReader::Run() {
+    try {
+        for (size_t i = 0; i < reader_.GetRowGroupCount(); ++i) {
+            if (!reader_.RowGroupMayMatch(i)) {
+                continue;
+            }
+
+            uint64_t bytes = GetEncodedSize(i);
+            {
+                std::unique_lock lock(mutex_);
+                consumed_.wait(lock, [&] {
+                    return stopping_ || queue_.empty() ||
+                           (queue_.size() < options_.depth &&
+                            queuedBytes_ + bytes <= options_.memoryLimit);
+                });
+                if (stopping_) {
+                    return;
+                }
+            }
+
+            RowGroup rowGroup = reader_.ReadRowGroup(i, options_.projection);
+
+            {
+                std::lock_guard lock(mutex_);
+                queue_.push_back({std::move(rowGroup), bytes});
+                queuedBytes_ += bytes;
+            }
+            produced_.notify_one();
+        }
+    } catch (...) {
+        std::lock_guard lock(mutex_);
+        error_ = std::current_exception();
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+        finished_ = true;
+    }
+    produced_.notify_one();
+}
+
+uint64_t PrefetchingReader::GetEncodedSize(size_t index) const {
+    const auto& meta = reader_.GetRowGroupMeta(index);
+
+    uint64_t bytes = 0;
+    for (size_t column : options_.projection) {
+        bytes += meta.columns.at(column).size;
+    }
+    return bytes;
+}
+
+}  // namespace Columnar::IO
@@ -0,0 +1,264 @@
+#include <io/uring_reader.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define COLUMNAR_HAS_IO_URING 1
+#endif
+
+namespace Columnar::IO {
+
+#ifdef COLUMNAR_HAS_IO_URING
+
+namespace {
+
+// a single SQE reads at most this much, larger requests complete short
+constexpr size_t kMaxReadSize = 1 << 30;
+
+std::runtime_error SystemError(const std::string& what, int error) {
+    return std::runtime_error(what + ": " + std::strerror(error));
+}
+
+unsigned* RingField(void* ring, uint32_t offset) {
+    return reinterpret_cast<unsigned*>(static_cast<char*>(ring) + offset);
+}
+
+}  // namespace
+
+UringReader::UringReader(const std::string& filename, unsigned queueDepth) {
+    if (queueDepth == 0) {
+        throw std::invalid_argument("io_uring queue depth must be positive");
+    }
+
+    fileFd_ = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fileFd_ < 0) {
+        throw SystemError("Cannot open file " + filename, errno);
+    }
+
+    io_uring_params params{};
+    ringFd_ = static_cast<int>(
+        ::syscall(__NR_io_uring_setup, queueDepth, &params));
+    if (ringFd_ < 0) {
+        int error = errno;
+        Close();
+        throw SystemError("io_uring is not available", error);
+    }
+    queueDepth_ = std::min(queueDepth, params.sq_entries);
+
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize_ =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap) {
+        sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+    }
+
+    sqRing_ = ::mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQ_RING);
+    if (sqRing_ == MAP_FAILED) {
+        sqRing_ = nullptr;
+        int error = errno;
+        Close();
+        throw SystemError("Cannot map io_uring submission ring", error);
+    }
+
+    if (singleMmap) {
+        cqRing_ = sqRing_;
+    } else {
+        cqRing_ = ::mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ringFd_,
+                         IORING_OFF_CQ_RING);
+        if (cqRing_ == MAP_FAILED) {
+            cqRing_ = nullptr;
+            int error = errno;
+            Close();
+            throw SystemError("Cannot map io_uring completion ring", error);
+        }
+    }
+
+    sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = ::mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQES);
+    if (sqes_ == MAP_FAILED) {
+        sqes_ = nullptr;
+        int error = errno;
+        Close();
+        throw SystemError("Cannot map io_uring submission entries", error);
+    }
+
+    sqTail_ = RingField(sqRing_, params.sq_off.tail);
+    sqMask_ = *RingField(sqRing_, params.sq_off.ring_mask);
+    sqArray_ = RingField(sqRing_, params.sq_off.array);
+    cqHead_ = RingField(cqRing_, params.cq_off.head);
+    cqTail_ = RingField(cqRing_, params.cq_off.tail);
+    cqMask_ = *RingField(cqRing_, params.cq_off.ring_mask);
+    cqes_ = static_cast<char*>(cqRing_) + params.cq_off.cqes;
+}
+
+UringReader::~UringReader() {
+    Close();
+}
+
+void UringReader::Read(std::span<const ReadRequest> requests) {
+    std::lock_guard lock(mutex_);
+
+    std::vector<size_t> done(requests.size(), 0);
+    std::deque<size_t> pending;
+    for (size_t i = 0; i < requests.size(); ++i) {
+        if (requests[i].size > 0) {
+            pending.push_back(i);
+        }
+    }
+
+    auto* sqes = static_cast<io_uring_sqe*>(sqes_);
+    auto* cqes = static_cast<io_uring_cqe*>(cqes_);
+    unsigned inFlight = 0;  // consumed by the kernel, not completed yet
+    unsigned queued = 0;    // in the submission ring, not consumed yet
+    int error = 0;          // first failed read
+    int enterError = 0;     // first failed io_uring_enter
+    bool endOfFile = false;
+
+    while (!pending.empty() || inFlight + queued > 0) {
+        // the kernel only looks at entries before the published tail
+        unsigned tail = *sqTail_;
+        while (!pending.empty() && inFlight + queued < queueDepth_) {
+            size_t i = pending.front();
+            pending.pop_front();
+
+            const auto& request = requests[i];
+            size_t remaining = request.size - done[i];
+
+            unsigned slot = tail & sqMask_;
+            io_uring_sqe& sqe = sqes[slot];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = IORING_OP_READ;
+            sqe.fd = fileFd_;
+            sqe.off = request.offset + done[i];
+            sqe.addr = reinterpret_cast<uint64_t>(request.destination +
+                                                  done[i]);
+            sqe.len = static_cast<uint32_t>(
+                std::min(remaining, kMaxReadSize));
+            sqe.user_data = i;
+            sqArray_[slot] = slot;
+            ++tail;
+            ++queued;
+        }
+        std::atomic_ref<unsigned>(*sqTail_).store(tail,
+                                                  std::memory_order_release);
+
+        int submitted = static_cast<int>(
+            ::syscall(__NR_io_uring_enter, ringFd_, queued, 1,
+                      IORING_ENTER_GETEVENTS, nullptr, 0));
+        if (submitted >= 0) {
+            queued -= static_cast<unsigned>(submitted);
+            inFlight += static_cast<unsigned>(submitted);
+        } else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            // reads in flight still write into caller buffers: retract the
+            // entries the kernel has not consumed and drain before throwing.
+            // Completions are reaped from the ring even if entering fails.
+            if (enterError == 0) {
+                enterError = errno;
+            }
+            tail -= queued;
+            std::atomic_ref<unsigned>(*sqTail_).store(
+                tail, std::memory_order_release);
+            queued = 0;
+            pending.clear();
+            std::this_thread::yield();
+        }
+
+        unsigned head = *cqHead_;
+        unsigned cqTail =
+            std::atomic_ref<unsigned>(*cqTail_).load(std::memory_order_acquire);
+        for (; head != cqTail; ++head) {
+            const io_uring_cqe& cqe = cqes[head & cqMask_];
+            size_t i = static_cast<size_t>(cqe.user_data);
+            --inFlight;
+
+            if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+                pending.push_back(i);
+            } else if (cqe.res < 0) {
+                error = -cqe.res;
+            } else if (cqe.res == 0) {
+                endOfFile = true;
+            } else {
+                done[i] += static_cast<size_t>(cqe.res);
+                if (done[i] < requests[i].size) {
+                    pending.push_back(i);
+                }
+            }
+        }
+        std::atomic_ref<unsigned>(*cqHead_).store(head,
+                                                  std::memory_order_release);
+
+        // reads still in flight write into caller buffers, so failures are
+        // only reported once the queue is drained
+        if (error != 0 || enterError != 0 || endOfFile) {
+            pending.clear();
+        }
+    }
+
+    if (enterError != 0) {
+        throw SystemError("io_uring_enter failed", enterError);
+    }
+    if (error != 0) {
+        throw SystemError("io_uring read failed", error);
+    }
+    if (endOfFile) {
+        throw std::runtime_error("Unexpected end of file");
+    }
+}
+
+void UringReader::Close() {
+    if (sqes_) {
+        ::munmap(sqes_, sqesSize_);
+        sqes_ = nullptr;
+    }
+    if (cqRing_ && cqRing_ != sqRing_) {
+        ::munmap(cqRing_, cqRingSize_);
+    }
+    cqRing_ = nullptr;
+    if (sqRing_) {
+        ::munmap(sqRing_, sqRingSize_);
+        sqRing_ = nullptr;
+    }
+    if (ringFd_ >= 0) {
+        ::close(ringFd_);
+        ringFd_ = -1;
+    }
+    if (fileFd_ >= 0) {
+        ::close(fileFd_);
+        fileFd_ = -1;
+    }
+}
+
+#else
+
+UringReader::UringReader(const std::string&, unsigned) {
+    throw std::runtime_error("io_uring is not available on this platform");
+}
+
+UringReader::~UringReader() = default;
+
+void UringReader::Read(std::span<const ReadRequest>) {
+    throw std::logic_error("io_uring is not available on this platform");
+}
+
+void UringReader::Close() {}
+
+#endif
+
+}  // namespace Columnar::IO
@@ -0,0 +1,104 @@
+#include <parser/csv_column_parser.h>
+#include <parser/value_parser.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Columnar::Parser {
+
+namespace {
+
+// Returns the rows (relative to the first appended one) of empty fields,
+// which are NULL when `nullable`
+template <typename TVector, typename TParse>
+std::vector<size_t> AppendFields(std::string_view data,
+                                 const CsvTokens& tokens,
+                                 std::span<const uint32_t> recordFirstFields,
+                                 size_t fieldOffset,
+                                 const CsvParserOptions& options,
+                                 bool nullable, TVector& out, TParse parse) {
+    // reused for the few fields that need unescaping
+    std::string scratch;
+    std::vector<size_t> nulls;
+
+    for (size_t row = 0; row < recordFirstFields.size(); ++row) {
+        size_t field = recordFirstFields[row] + fieldOffset;
+        size_t begin = tokens.GetFieldBegin(field);
+        std::string_view raw =
+            data.substr(begin, tokens.fieldEnds[field] - begin);
+
+        if (nullable && raw.empty()) {
+            out.push_back({});
+            nulls.push_back(row);
+            continue;
+        }
+
+        try {
+            out.push_back(parse(UnescapeCsvField(raw, scratch, options)));
+        } catch (const std::invalid_argument& e) {
+            throw std::invalid_argument("Field at byte " +
+                                        std::to_string(begin) + ": " +
+                                        e.what());
+        }
+    }
+
+    return nulls;
+}
+
+}  // namespace
+
+void AppendCsvColumn(std::string_view data, const CsvTokens& tokens,
+                     std::span<const uint32_t> recordFirstFields,
+                     size_t fieldOffset, Column& column,
+                     const CsvParserOptions& options) {
+    const size_t firstRow = column.GetRowCount();
+    const bool nullable = column.GetType() != Types::DataType::STRING;
+
+    auto append = [&](auto& out, auto parse) {
+        out.reserve(out.size() + recordFirstFields.size());
+        std::vector<size_t> nulls =
+            AppendFields(data, tokens, recordFirstFields, fieldOffset,
+                         options, nullable, out, parse);
+
+        if (!nulls.empty() || column.GetValidity()) {
+            Bitmap& validity = column.GetMutableValidity();
+            for (size_t row : nulls) {
+                validity.Set(firstRow + row, false);
+            }
+        }
+    };
+
+    switch (column.GetType()) {
+        case Types::DataType::INT16:
+            append(column.GetMutuableTypedData<int16_t>(),
+                   ParseInteger<int16_t>);
+            break;
+        case Types::DataType::INT32:
+            append(column.GetMutuableTypedData<int32_t>(),
+                   ParseInteger<int32_t>);
+            break;
+        case Types::DataType::INT64:
+            append(column.GetMutuableTypedData<int64_t>(),
+                   ParseInteger<int64_t>);
+            break;
+        case Types::DataType::DATE:
+            append(column.GetMutuableTypedData<int32_t>(), ParseDate);
+            break;
+        case Types::DataType::TIMESTAMP:
+            append(column.GetMutuableTypedData<int64_t>(), ParseTimestamp);
+            break;
+        case Types::DataType::BOOL:
+            append(column.GetMutuableTypedData<bool>(), ParseBool);
+            break;
+        case Types::DataType::STRING:
+            append(column.GetMutuableTypedData<std::string>(),
+                   [](std::string_view value) { return value; });
+            break;
+        default:
+            throw std::invalid_argument("Unsupported data type for parsing: " +
+                                        Types::GetTypeName(column.GetType()));
+    }
+}
+
+}  // namespace Columnar::Parser
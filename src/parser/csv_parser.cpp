@@ -1,59 +1,41 @@
 #include <parser/csv_parser.h>
-
-#include <stdexcept>
+#include <parser/csv_tokenizer.h>
 
 namespace Columnar::Parser {
 
 std::vector<std::string> ParseCsvLine(const std::string& line,
                                       const CsvParserOptions& options) {
-    std::vector<std::string> fields;
-    std::string currentField;
-    bool inQuotes = false;
-
-    size_t i = 0;
-    while (i < line.size()) {
-        char c = line[i];
-
-        if (inQuotes) {
-            if (c == options.quote) {
-                // escape quote ?
-                if (i + 1 < line.size() && line[i + 1] == options.quote) {
-                    currentField += options.quote;
-                    i += 2;
-                } else {
-                    inQuotes = false;
-                    ++i;
-                }
-            } else {
-                currentField += c;
-                ++i;
-            }
-        } else {
-            if (c == options.quote) {
-                inQuotes = true;
-                ++i;
-            } else if (c == options.delimiter) {
-                fields.push_back(currentField);
-                currentField.clear();
-                ++i;
-            } else if (c == '\r') {  // windows compatible bullshit
-                ++i;
-            } else {
-                currentField += c;
-                ++i;
-            }
-        }
-    }
+    CsvTokens tokens;
+    TokenizeCsv(line, tokens, options);
 
-    fields.push_back(currentField);
+    std::vector<std::string> fields;
+    fields.reserve(tokens.fieldEnds.size());
 
-    if (inQuotes) {
-        throw std::runtime_error("Unclosed quote in CSV line");
+    std::string scratch;
+    for (size_t i = 0; i < tokens.fieldEnds.size(); ++i) {
+        size_t begin = tokens.GetFieldBegin(i);
+        std::string_view raw(line.data() + begin, tokens.fieldEnds[i] - begin);
+        fields.emplace_back(UnescapeCsvField(raw, scratch, options));
     }
 
+    if (fields.empty()) {
+        fields.emplace_back();
+    }
     return fields;
 }
 
+size_t FindRecordStart(std::string_view data, size_t from, bool inQuotes,
+                       const CsvParserOptions& options) {
+    for (size_t i = from; i < data.size(); ++i) {
+        if (data[i] == options.quote) {
+            inQuotes = !inQuotes;
+        } else if (data[i] == '\n' && !inQuotes) {
+            return i + 1;
+        }
+    }
+    return data.size();
+}
+
 bool IsFieldNeedEscpaing(const std::string& field,
                          const CsvParserOptions& options) {
     for (char c : field) {
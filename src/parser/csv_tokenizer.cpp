@@ -0,0 +1,222 @@
+#include <parser/csv_tokenizer.h>
+
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define COLUMNAR_CSV_X86 1
+#endif
+
+namespace Columnar::Parser {
+
+namespace {
+
+constexpr size_t kBlockSize = 64;
+
+struct BlockMasks {
+    uint64_t quote = 0;
+    uint64_t delimiter = 0;
+    uint64_t newline = 0;
+};
+
+using ClassifyFn = BlockMasks (*)(const char* block, char quote,
+                                  char delimiter);
+
+BlockMasks ClassifyScalar(const char* block, char quote, char delimiter) {
+    BlockMasks masks;
+    for (size_t i = 0; i < kBlockSize; ++i) {
+        uint64_t bit = uint64_t{1} << i;
+        masks.quote |= block[i] == quote ? bit : 0;
+        masks.delimiter |= block[i] == delimiter ? bit : 0;
+        masks.newline |= block[i] == '\n' ? bit : 0;
+    }
+    return masks;
+}
+
+#ifdef COLUMNAR_CSV_X86
+
+__attribute__((target("sse2"))) BlockMasks ClassifySse2(const char* block,
+                                                        char quote,
+                                                        char delimiter) {
+    const __m128i quotes = _mm_set1_epi8(quote);
+    const __m128i delimiters = _mm_set1_epi8(delimiter);
+    const __m128i newlines = _mm_set1_epi8('\n');
+
+    BlockMasks masks;
+    for (size_t i = 0; i < kBlockSize; i += 16) {
+        __m128i chunk = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(block + i));
+        uint16_t quote16 = static_cast<uint16_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quotes)));
+        uint16_t delimiter16 = static_cast<uint16_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, delimiters)));
+        uint16_t newline16 = static_cast<uint16_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newlines)));
+        masks.quote |= uint64_t{quote16} << i;
+        masks.delimiter |= uint64_t{delimiter16} << i;
+        masks.newline |= uint64_t{newline16} << i;
+    }
+    return masks;
+}
+
+__attribute__((target("avx2"))) BlockMasks ClassifyAvx2(const char* block,
+                                                        char quote,
+                                                        char delimiter) {
+    const __m256i quotes = _mm256_set1_epi8(quote);
+    const __m256i delimiters = _mm256_set1_epi8(delimiter);
+    const __m256i newlines = _mm256_set1_epi8('\n');
+
+    BlockMasks masks;
+    for (size_t i = 0; i < kBlockSize; i += 32) {
+        __m256i chunk = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(block + i));
+        uint32_t quote32 = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, quotes)));
+        uint32_t delimiter32 = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, delimiters)));
+        uint32_t newline32 = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newlines)));
+        masks.quote |= uint64_t{quote32} << i;
+        masks.delimiter |= uint64_t{delimiter32} << i;
+        masks.newline |= uint64_t{newline32} << i;
+    }
+    return masks;
+}
+
+#endif
+
+ClassifyFn GetClassifier(CsvTokenizerIsa isa) {
+    switch (isa) {
+#ifdef COLUMNAR_CSV_X86
+        case CsvTokenizerIsa::AVX2:
+            return ClassifyAvx2;
+        case CsvTokenizerIsa::SSE2:
+            return ClassifySse2;
+#endif
+        case CsvTokenizerIsa::SCALAR:
+            return ClassifyScalar;
+        default:
+            throw std::invalid_argument("CSV tokenizer ISA is not supported");
+    }
+}
+
+// bit i of the result is the XOR of bits 0..i: set inside quoted regions
+uint64_t PrefixXor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+}  // namespace
+
+CsvTokenizerIsa GetCsvTokenizerIsa() {
+#ifdef COLUMNAR_CSV_X86
+    static const CsvTokenizerIsa isa = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return CsvTokenizerIsa::AVX2;
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return CsvTokenizerIsa::SSE2;
+        }
+        return CsvTokenizerIsa::SCALAR;
+    }();
+    return isa;
+#else
+    return CsvTokenizerIsa::SCALAR;
+#endif
+}
+
+void TokenizeCsv(std::string_view data, CsvTokens& tokens,
+                 const CsvParserOptions& options) {
+    TokenizeCsv(data, tokens, options, GetCsvTokenizerIsa());
+}
+
+void TokenizeCsv(std::string_view data, CsvTokens& tokens,
+                 const CsvParserOptions& options, CsvTokenizerIsa isa) {
+    if (data.size() >= std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("CSV block must be smaller than 4 GiB");
+    }
+
+    ClassifyFn classify = GetClassifier(isa);
+    tokens.Clear();
+
+    uint64_t insideCarry = 0;  // all ones if the previous block ended quoted
+    char tail[kBlockSize];
+
+    for (size_t base = 0; base < data.size(); base += kBlockSize) {
+        const char* block = data.data() + base;
+        uint64_t valid = ~uint64_t{0};
+
+        size_t remaining = data.size() - base;
+        if (remaining < kBlockSize) {
+            std::memset(tail, 0, sizeof(tail));
+            std::memcpy(tail, block, remaining);
+            block = tail;
+            valid = (uint64_t{1} << remaining) - 1;
+        }
+
+        BlockMasks masks = classify(block, options.quote, options.delimiter);
+        uint64_t inside = PrefixXor(masks.quote & valid) ^ insideCarry;
+        insideCarry = static_cast<uint64_t>(static_cast<int64_t>(inside) >> 63);
+
+        uint64_t newlines = masks.newline & ~inside & valid;
+        uint64_t separators = (masks.delimiter & ~inside & valid) | newlines;
+
+        while (separators != 0) {
+            size_t bit = std::countr_zero(separators);
+            tokens.fieldEnds.push_back(static_cast<uint32_t>(base + bit));
+            if ((newlines >> bit) & 1) {
+                tokens.recordEnds.push_back(
+                    static_cast<uint32_t>(tokens.fieldEnds.size()));
+            }
+            separators &= separators - 1;
+        }
+    }
+
+    if (insideCarry != 0) {
+        throw std::runtime_error("Unclosed quote in CSV data");
+    }
+
+    // last record without a trailing newline
+    if (!data.empty() && data.back() != '\n') {
+        tokens.fieldEnds.push_back(static_cast<uint32_t>(data.size()));
+        tokens.recordEnds.push_back(
+            static_cast<uint32_t>(tokens.fieldEnds.size()));
+    }
+}
+
+std::string_view UnescapeCsvField(std::string_view raw, std::string& scratch,
+                                  const CsvParserOptions& options) {
+    const char special[] = {options.quote, '\r'};
+    if (raw.find_first_of(std::string_view(special, 2)) ==
+        std::string_view::npos) {
+        return raw;
+    }
+
+    scratch.clear();
+    bool inQuotes = false;
+    for (size_t i = 0; i < raw.size(); ++i) {
+        char c = raw[i];
+        if (c == options.quote) {
+            if (inQuotes && i + 1 < raw.size() && raw[i + 1] == options.quote) {
+                scratch += options.quote;
+                ++i;
+            } else {
+                inQuotes = !inQuotes;
+            }
+        } else if (c != '\r' || inQuotes) {
+            scratch += c;
+        }
+    }
+    return scratch;
+}
+
+}  // namespace Columnar::Parser
@@ -1,12 +1,12 @@
 #include <core/types.h>
 #include <parser/value_parser.h>
-#include <util/str.h>
 
+#include <cctype>
 #include <charconv>
 #include <cstdint>
-#include <ctime>
-#include <iomanip>
-#include <sstream>
+#include <cstring>
+#include <limits>
+#include <optional>
 #include <stdexcept>
 #include <system_error>
 
@@ -14,173 +14,276 @@ namespace Columnar::Parser {
 
 namespace {
 
-// TODO: generalize implementation for all parse int
-
-// Parsers
+std::string_view Strip(std::string_view str) {
+    size_t start = str.find_first_not_of(" \t\r\n");
+    if (start == std::string_view::npos) {
+        return {};
+    }
+    size_t end = str.find_last_not_of(" \t\r\n");
+    return str.substr(start, end - start + 1);
+}
 
-int16_t ParseInt16(const std::string& str) {
-    std::string stripped = str::strip(str);
-    if (stripped.empty()) {
-        throw std::invalid_argument("Cannot parse empty string as int16");
+bool EqualsIgnoreCase(std::string_view str, std::string_view lower) {
+    if (str.size() != lower.size()) {
+        return false;
     }
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(str[i])) != lower[i]) {
+            return false;
+        }
+    }
+    return true;
+}
 
-    int16_t result;
-    auto [ptr, err_code] = std::from_chars(
-        stripped.data(), stripped.data() + stripped.size(), result);
+template <typename T>
+constexpr const char* kIntegerName = "";
+template <>
+constexpr const char* kIntegerName<int16_t> = "int16";
+template <>
+constexpr const char* kIntegerName<int32_t> = "int32";
+template <>
+constexpr const char* kIntegerName<int64_t> = "int64";
 
-    if (err_code != std::errc{} || ptr != (stripped.data() + stripped.size())) {
-        throw std::invalid_argument("Cannot parse '" + str + "' as int16");
-    }
+[[maybe_unused]] int64_t ParseInt128(  // TODO: implement int128 support
+    const std::string& str) {
+    throw std::runtime_error("not implemented yet");
+    return str[0];  // some garbage for clangd
+}
 
-    return result;
+constexpr int64_t kSecondsPerDay = 86400;
+
+uint64_t Load8(const char* p) {
+    uint64_t chunk;
+    std::memcpy(&chunk, p, sizeof(chunk));
+    return chunk;
 }
 
-int32_t ParseInt32(const std::string& str) {
-    std::string stripped = str::strip(str);
-    if (stripped.empty()) {
-        throw std::invalid_argument("Cannot parse empty string as int32");
-    }
+// SWAR check that every byte selected by `mask` is an ASCII digit: after
+// XOR with '0' digits become 0..9, and adding 0x76 sets the high bit of
+// every byte that was 10 or more
+bool AreDigits(uint64_t chunk, uint64_t mask) {
+    uint64_t x = chunk ^ 0x3030303030303030ULL;
+    return ((x | (x + 0x7676767676767676ULL)) & 0x8080808080808080ULL &
+            mask) == 0;
+}
 
-    int32_t result;
-    auto [ptr, err_code] = std::from_chars(
-        stripped.data(), stripped.data() + stripped.size(), result);
+unsigned Digits2(const char* p) {
+    return (p[0] - '0') * 10 + (p[1] - '0');
+}
 
-    if (err_code != std::errc{} || ptr != (stripped.data() + stripped.size())) {
-        throw std::invalid_argument("Cannot parse '" + str + "' as int32");
+unsigned Digits4(const char* p) {
+    return Digits2(p) * 100 + Digits2(p + 2);
+}
+
+bool IsLeapYear(int32_t year) {
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+unsigned DaysInMonth(int32_t year, unsigned month) {
+    constexpr unsigned kDays[] = {31, 28, 31, 30, 31, 30,
+                                  31, 31, 30, 31, 30, 31};
+    return month == 2 && IsLeapYear(year) ? 29 : kDays[month - 1];
+}
+
+// "YYYY-MM-DD" at p, validated; nullopt if malformed
+std::optional<int32_t> ParseCivilDate(const char* p) {
+    // bytes 0-7 are "YYYY-MM-", bytes 4 and 7 are separators
+    constexpr uint64_t kDateMask = 0x00FFFF00FFFFFFFFULL;
+    if (p[4] != '-' || p[7] != '-' || !AreDigits(Load8(p), kDateMask) ||
+        !std::isdigit(static_cast<unsigned char>(p[8])) ||
+        !std::isdigit(static_cast<unsigned char>(p[9]))) {
+        return std::nullopt;
     }
 
-    return result;
+    int32_t year = static_cast<int32_t>(Digits4(p));
+    unsigned month = Digits2(p + 5);
+    unsigned day = Digits2(p + 8);
+    if (month < 1 || month > 12 || day < 1 || day > DaysInMonth(year, month)) {
+        return std::nullopt;
+    }
+    return DaysFromCivil(year, month, day);
 }
 
-int64_t ParseInt64(const std::string& str) {
-    std::string stripped = str::strip(str);
+void WriteDigits(char* out, unsigned value, size_t width) {
+    for (size_t i = width; i > 0; --i) {
+        out[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+}  // namespace
+
+template <typename T>
+T ParseInteger(std::string_view str) {
+    std::string_view stripped = Strip(str);
     if (stripped.empty()) {
-        throw std::invalid_argument("Cannot parse empty string as int64");
+        throw std::invalid_argument(
+            std::string("Cannot parse empty string as ") + kIntegerName<T>);
     }
 
-    int64_t result;
+    T result;
     auto [ptr, err_code] = std::from_chars(
         stripped.data(), stripped.data() + stripped.size(), result);
 
     if (err_code != std::errc{} || ptr != (stripped.data() + stripped.size())) {
-        throw std::invalid_argument("Cannot parse '" + str + "' as int64");
+        throw std::invalid_argument("Cannot parse '" + std::string(str) +
+                                    "' as " + kIntegerName<T>);
     }
 
     return result;
 }
 
-[[maybe_unused]] int64_t ParseInt128(  // TODO: implement int128 support
-    const std::string& str) {
-    throw std::runtime_error("not implemented yet");
-    return str[0];  // some garbage for clangd
-}
+template int16_t ParseInteger<int16_t>(std::string_view str);
+template int32_t ParseInteger<int32_t>(std::string_view str);
+template int64_t ParseInteger<int64_t>(std::string_view str);
 
-bool ParseBool(const std::string& str) {
-    std::string pretty_str = str::tolower(str::strip(str));
+bool ParseBool(std::string_view str) {
+    std::string_view stripped = Strip(str);
 
-    if (pretty_str == "true") {
+    if (EqualsIgnoreCase(stripped, "true")) {
         return true;
     }
 
-    if (pretty_str == "false") {
+    if (EqualsIgnoreCase(stripped, "false")) {
         return false;
     }
 
-    throw std::invalid_argument("Cannot parse '" + str + "' as bool");
+    throw std::invalid_argument("Cannot parse '" + std::string(str) +
+                                "' as bool");
+}
+
+int32_t DaysFromCivil(int32_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const int32_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    const unsigned dayOfYear =
+        (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned dayOfEra =
+        yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int32_t>(dayOfEra) - 719468;
 }
 
-/**
- *   @brief Parse date in format YYYY-MM-DD
- *   @return Days since unix epoch (1970-01-01)
- */
-int32_t ParseDate(const std::string& str) {
-    std::string stripped = str::strip(str);
+void CivilFromDays(int32_t days, int32_t& year, unsigned& month,
+                   unsigned& day) {
+    int64_t z = static_cast<int64_t>(days) + 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned dayOfEra = static_cast<unsigned>(z - era * 146097);
+    const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 +
+                                dayOfEra / 36524 - dayOfEra / 146096) /
+                               365;
+    const unsigned dayOfYear =
+        dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const unsigned mp = (5 * dayOfYear + 2) / 153;
+
+    day = dayOfYear - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int32_t>(yearOfEra + era * 400) + (month <= 2);
+}
 
-    std::tm tm = {};
-    std::istringstream ss(stripped);
-    ss >> std::get_time(&tm, "%Y-%m-%d");
+int32_t ParseDate(std::string_view str) {
+    std::string_view stripped = Strip(str);
 
-    if (ss.fail()) {
-        throw std::invalid_argument("Cannot parse '" + str +
-                                    "' as date (expected YYYY-MM-DD)");
+    std::optional<int32_t> days;
+    if (stripped.size() == kDateLength) {
+        days = ParseCivilDate(stripped.data());
     }
 
-    tm.tm_hour = 12;
-    std::time_t time = std::mktime(&tm);
-    if (time == -1) {
-        throw std::invalid_argument("Invalid date: " + str);
+    if (!days) {
+        throw std::invalid_argument("Cannot parse '" + std::string(str) +
+                                    "' as date (expected YYYY-MM-DD)");
     }
-
-    constexpr int64_t kSecondsPerDay = 86400;
-    return static_cast<int32_t>(time / kSecondsPerDay);
+    return *days;
 }
 
-/**
- *   @brief Parse timestamp in format "YYYY-MM-DD HH:MM:SS"
- *   @return Seconds since unix epoch (1970-01-01)
-*/
-int64_t ParseTimestamp(const std::string& str) {
-    std::string stripped = str::strip(str);
+int64_t ParseTimestamp(std::string_view str) {
+    std::string_view stripped = Strip(str);
+    const char* p = stripped.data();
 
-    std::tm tm = {};
-    std::istringstream ss(stripped);
-    ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+    // "YYYY-MM-DD HH:MM:SS", 'T' is accepted as the date/time separator
+    std::optional<int32_t> days;
+    if (stripped.size() == kTimestampLength && (p[10] == ' ' || p[10] == 'T') &&
+        p[13] == ':' && p[16] == ':' &&
+        AreDigits(Load8(p + 11), 0xFFFF00FFFF00FFFFULL)) {
+        days = ParseCivilDate(p);
+    }
 
-    if (ss.fail()) {
+    unsigned hours = days ? Digits2(p + 11) : 0;
+    unsigned minutes = days ? Digits2(p + 14) : 0;
+    unsigned seconds = days ? Digits2(p + 17) : 0;
+    if (!days || hours > 23 || minutes > 59 || seconds > 59) {
         throw std::invalid_argument(
-            "Cannot parse '" + str +
+            "Cannot parse '" + std::string(str) +
             "' as timestamp (expected YYYY-MM-DD HH:MM:SS)");
     }
 
-    std::time_t time = std::mktime(&tm);
-    if (time == -1) {
-        throw std::invalid_argument("Invalid timestamp: " + str);
-    }
-
-    return static_cast<int64_t>(time);
+    return static_cast<int64_t>(*days) * kSecondsPerDay + hours * 3600 +
+           minutes * 60 + seconds;
 }
 
-// Formatters:
-
-std::string FormatDate(int32_t daysSinceEpoch) {
-    constexpr int64_t kSecondsPerDay = 86400;
-    std::time_t time =
-        static_cast<std::time_t>(daysSinceEpoch) * kSecondsPerDay;
-    std::tm* tm = std::gmtime(&time);
+char* FormatDate(int32_t daysSinceEpoch, char* out) {
+    int32_t year;
+    unsigned month;
+    unsigned day;
+    CivilFromDays(daysSinceEpoch, year, month, day);
 
-    if (!tm) {
-        throw std::runtime_error("Cannot format date");
+    if (year < 0 || year > 9999) {
+        throw std::out_of_range("Date is out of the YYYY range: " +
+                                std::to_string(daysSinceEpoch));
     }
 
-    std::ostringstream ss;
-    ss << std::put_time(tm, "%Y-%m-%d");
-
-    return ss.str();
+    WriteDigits(out, static_cast<unsigned>(year), 4);
+    out[4] = '-';
+    WriteDigits(out + 5, month, 2);
+    out[7] = '-';
+    WriteDigits(out + 8, day, 2);
+    return out + kDateLength;
 }
 
-std::string FormatTimestamp(int64_t secondsSinceEpoch) {
-    std::time_t time = static_cast<std::time_t>(secondsSinceEpoch);
-    std::tm* tm = std::gmtime(&time);
+char* FormatTimestamp(int64_t secondsSinceEpoch, char* out) {
+    int64_t days = secondsSinceEpoch / kSecondsPerDay;
+    int64_t rest = secondsSinceEpoch % kSecondsPerDay;
+    if (rest < 0) {
+        rest += kSecondsPerDay;
+        --days;
+    }
 
-    if (!tm) {
-        throw std::runtime_error("Cannot format timestamp");
+    if (days < std::numeric_limits<int32_t>::min() ||
+        days > std::numeric_limits<int32_t>::max()) {
+        throw std::out_of_range("Timestamp is out of range: " +
+                                std::to_string(secondsSinceEpoch));
     }
 
-    std::ostringstream ss;
-    ss << std::put_time(tm, "%Y-%m-%d %H:%M:%S");
-    return ss.str();
+    char* p = FormatDate(static_cast<int32_t>(days), out);
+    unsigned seconds = static_cast<unsigned>(rest);
+    *p = ' ';
+    WriteDigits(p + 1, seconds / 3600, 2);
+    p[3] = ':';
+    WriteDigits(p + 4, seconds / 60 % 60, 2);
+    p[6] = ':';
+    WriteDigits(p + 7, seconds % 60, 2);
+    return out + kTimestampLength;
 }
 
-}  // namespace
+std::string FormatDate(int32_t daysSinceEpoch) {
+    std::string result(kDateLength, '\0');
+    FormatDate(daysSinceEpoch, result.data());
+    return result;
+}
+
+std::string FormatTimestamp(int64_t secondsSinceEpoch) {
+    std::string result(kTimestampLength, '\0');
+    FormatTimestamp(secondsSinceEpoch, result.data());
+    return result;
+}
 
 Types::AnyColumnType ParseValue(const std::string& str, Types::DataType type) {
     switch (type) {
         case Types::DataType::INT16:
-            return ParseInt16(str);
+            return ParseInteger<int16_t>(str);
         case Types::DataType::INT32:
-            return ParseInt32(str);
+            return ParseInteger<int32_t>(str);
         case Types::DataType::INT64:
-            return ParseInt64(str);
+            return ParseInteger<int64_t>(str);
         case Types::DataType::BOOL:
             return ParseBool(str);
         case Types::DataType::STRING:
@@ -0,0 +1,236 @@
+#include <util/statistics.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Columnar {
+
+namespace {
+
+std::optional<int64_t> AsInteger(const TStatistics::TMinMax& value) {
+    return std::visit(
+        Types::overloaded{
+            [](int16_t v) -> std::optional<int64_t> { return v; },
+            [](int32_t v) -> std::optional<int64_t> { return v; },
+            [](int64_t v) -> std::optional<int64_t> { return v; },
+            [](const auto&) -> std::optional<int64_t> { return std::nullopt; }},
+        value);
+}
+
+template <typename T>
+int ThreeWay(const T& lhs, const T& rhs) {
+    if (lhs < rhs) {
+        return -1;
+    }
+    return rhs < lhs ? 1 : 0;
+}
+
+template <typename T>
+void ComputeMinMax(const std::vector<T>& vec, TStatistics& stats) {
+    if (vec.empty()) {
+        return;
+    }
+
+    auto [minIt, maxIt] = std::minmax_element(vec.begin(), vec.end());
+    stats.min_value = *minIt;
+    stats.max_value = *maxIt;
+}
+
+// NULL rows hold placeholder values and are skipped
+template <typename T>
+void ComputeMinMax(const std::vector<T>& vec, const Bitmap& validity,
+                   TStatistics& stats) {
+    std::optional<T> min;
+    std::optional<T> max;
+    for (size_t i = 0; i < vec.size(); ++i) {
+        if (!validity[i]) {
+            continue;
+        }
+        if (!min || vec[i] < *min) {
+            min = vec[i];
+        }
+        if (!max || *max < vec[i]) {
+            max = vec[i];
+        }
+    }
+
+    if (min) {
+        stats.min_value = *min;
+        stats.max_value = *max;
+    }
+}
+
+void ComputeStringStatistics(const StringVector& vec, const Bitmap* validity,
+                             TStatistics& stats) {
+    std::optional<std::string_view> min;
+    std::optional<std::string_view> max;
+    size_t minLength = 0;
+    size_t maxLength = 0;
+    size_t totalLength = 0;
+
+    for (size_t i = 0; i < vec.size(); ++i) {
+        if (validity && !(*validity)[i]) {
+            continue;
+        }
+
+        std::string_view value = vec[i];
+        if (!min) {
+            min = max = value;
+            minLength = maxLength = value.size();
+        }
+        min = std::min(*min, value);
+        max = std::max(*max, value);
+        minLength = std::min(minLength, value.size());
+        maxLength = std::max(maxLength, value.size());
+        totalLength += value.size();
+    }
+
+    stats.minStringLength = minLength;
+    stats.maxStringLength = maxLength;
+    stats.totalStringLength = totalLength;
+
+    if (min && min->size() <= TStatistics::kMaxStringMinMaxLength &&
+        max->size() <= TStatistics::kMaxStringMinMaxLength) {
+        stats.min_value = std::string(*min);
+        stats.max_value = std::string(*max);
+    }
+}
+
+}  // namespace
+
+TStatistics::TStatistics(Types::DataType type) {
+    if (type == Types::DataType::STRING) {
+        minStringLength = 0;
+        maxStringLength = 0;
+        totalStringLength = 0;
+    }
+}
+
+TStatistics TStatistics::Compute(const Column& column) {
+    TStatistics stats(column.GetType());
+    stats.rowCount = column.GetRowCount();
+    stats.nullCount = column.GetNullCount();
+
+    const Bitmap* validity = column.GetValidity();
+
+    std::visit(
+        Types::overloaded{
+            [&stats, validity](const Bitmap& vec) {
+                size_t validCount = stats.rowCount - stats.nullCount;
+                if (validCount == 0) {
+                    return;
+                }
+
+                size_t setCount = vec.CountSet();
+                if (validity) {
+                    Bitmap valid = vec;
+                    valid &= *validity;
+                    setCount = valid.CountSet();
+                }
+                stats.min_value = setCount == validCount;
+                stats.max_value = setCount != 0;
+            },
+            [&stats, validity](const StringVector& vec) {
+                if (vec.empty()) {
+                    return;
+                }
+
+                if (validity) {
+                    ComputeStringStatistics(vec, validity, stats);
+                    return;
+                }
+
+                auto offsets = vec.GetOffsets();
+                size_t minLength = vec[0].size();
+                size_t maxLength = vec[0].size();
+                for (size_t i = 0; i < vec.size(); ++i) {
+                    size_t length = offsets[i + 1] - offsets[i];
+                    minLength = std::min(minLength, length);
+                    maxLength = std::max(maxLength, length);
+                }
+                stats.minStringLength = minLength;
+                stats.maxStringLength = maxLength;
+                stats.totalStringLength = offsets.back();
+
+                auto [minIt, maxIt] =
+                    std::minmax_element(vec.begin(), vec.end());
+                if ((*minIt).size() <= kMaxStringMinMaxLength &&
+                    (*maxIt).size() <= kMaxStringMinMaxLength) {
+                    stats.min_value = std::string(*minIt);
+                    stats.max_value = std::string(*maxIt);
+                }
+            },
+            [&stats, validity](const auto& vec) {
+                if (validity) {
+                    ComputeMinMax(vec, *validity, stats);
+                } else {
+                    ComputeMinMax(vec, stats);
+                }
+            }},
+        column.GetData());
+
+    return stats;
+}
+
+bool TStatistics::HasMinMax() const {
+    return !std::holds_alternative<std::monostate>(min_value) &&
+           !std::holds_alternative<std::monostate>(max_value);
+}
+
+bool TStatistics::MayMatch(ECompareOp op, const TMinMax& constant) const {
+    if (rowCount > 0 && nullCount >= rowCount) {
+        return false;  // comparisons with NULL are never true
+    }
+
+    if (!HasMinMax()) {
+        return true;
+    }
+
+    auto cmpMin = CompareMinMax(min_value, constant);
+    auto cmpMax = CompareMinMax(max_value, constant);
+    if (!cmpMin || !cmpMax) {
+        return true;
+    }
+
+    switch (op) {
+        case ECompareOp::Equal:
+            return *cmpMin <= 0 && *cmpMax >= 0;
+        case ECompareOp::NotEqual:
+            return !(*cmpMin == 0 && *cmpMax == 0);
+        case ECompareOp::Less:
+            return *cmpMin < 0;
+        case ECompareOp::LessOrEqual:
+            return *cmpMin <= 0;
+        case ECompareOp::Greater:
+            return *cmpMax > 0;
+        case ECompareOp::GreaterOrEqual:
+            return *cmpMax >= 0;
+    }
+
+    return true;
+}
+
+std::optional<int> CompareMinMax(const TStatistics::TMinMax& lhs,
+                                 const TStatistics::TMinMax& rhs) {
+    auto lhsInt = AsInteger(lhs);
+    auto rhsInt = AsInteger(rhs);
+    if (lhsInt && rhsInt) {
+        return ThreeWay(*lhsInt, *rhsInt);
+    }
+
+    if (lhs.index() != rhs.index()) {
+        return std::nullopt;
+    }
+
+    if (const auto* l = std::get_if<bool>(&lhs)) {
+        return ThreeWay(*l, std::get<bool>(rhs));
+    }
+
+    if (const auto* l = std::get_if<std::string>(&lhs)) {
+        return ThreeWay(*l, std::get<std::string>(rhs));
+    }
+
+    return std::nullopt;
+}
+
+}  // namespace Columnar
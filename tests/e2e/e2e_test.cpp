@@ -1,15 +1,31 @@
 #include <gtest/gtest.h>
 
+#include <compute/aggregate.h>
+#include <compute/filter.h>
+#include <compute/group_by.h>
 #include <core/batch.h>
+#include <core/german_string.h>
 #include <core/schema.h>
+#include <io/csv_export.h>
 #include <io/csv_reader.h>
 #include <io/csv_writer.h>
 #include <io/format_reader.h>
 #include <io/format_writer.h>
+#include <io/parallel_csv_reader.h>
+#include <io/prefetching_reader.h>
+#include <parser/csv_tokenizer.h>
+#include <parser/value_parser.h>
 
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <set>
 #include <sstream>
+#include <thread>
 #include "core/row_group.h"
 #include "core/types.h"
 #include "parser/schema_parser.h"
@@ -31,6 +47,14 @@ void WriteFile(const std::string& filename, const std::string& content) {
     output << content;
 }
 
+// splitmix64, gives incompressible test values
+uint64_t Mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
 void RemoveFile(const std::string& filename) {
     if (std::filesystem::exists(filename)) {
         std::filesystem::remove(filename);
@@ -257,4 +281,1758 @@ TEST_F(FixtureE2E, LargeDataMultipleRowGroups) {
         << "Large data: product should be preserved";
 }
 
+TEST_F(FixtureE2E, AllTypesRoundTrip) {
+    const size_t numRows = 3000;
+
+    auto makeBatch = [numRows]() {
+        std::vector<int16_t> small;
+        std::vector<int32_t> medium;
+        std::vector<int64_t> large;
+        std::vector<bool> flags;
+        std::vector<std::string> names;
+
+        for (size_t i = 0; i < numRows; ++i) {
+            small.push_back(static_cast<int16_t>(i % 100 - 50));
+            medium.push_back(static_cast<int32_t>(i * 7));
+            large.push_back(static_cast<int64_t>(i) * 1'000'000'007LL);
+            flags.push_back(i % 3 == 0);
+            names.push_back(i % 5 == 0 ? std::string{}
+                                       : "name_" + std::to_string(i));
+        }
+
+        std::vector<Column> columns;
+        columns.push_back(Column::CreateInt16("small", std::move(small)));
+        columns.push_back(Column::CreateInt32("medium", std::move(medium)));
+        columns.push_back(Column::CreateInt64("large", std::move(large)));
+        columns.push_back(Column::CreateBool("flags", std::move(flags)));
+        columns.push_back(Column::CreateString("names", std::move(names)));
+        return Batch(std::move(columns));
+    };
+
+    Batch expected = makeBatch();
+
+    {
+        IO::FormatWriter formatWriter(kTestIyxFile);
+        formatWriter.Begin(expected.GetSchema());
+        formatWriter.WriteRowGroup(RowGroup(makeBatch()));
+        formatWriter.End();
+    }
+
+    IO::FormatReader formatReader(kTestIyxFile);
+    formatReader.Open();
+    ASSERT_EQ(formatReader.GetRowGroupCount(), 1);
+
+    RowGroup rg = formatReader.ReadRowGroup(0);
+    const Batch& batch = rg.GetBatch();
+    ASSERT_EQ(batch.GetRowCount(), numRows);
+
+    for (size_t i = 0; i < expected.GetColumnCount(); ++i) {
+        EXPECT_EQ(batch.GetColumn(i).GetData(),
+                  expected.GetColumn(i).GetData())
+            << "Column " << expected.GetColumn(i).GetName() << " mismatch";
+    }
+
+    // BOOL chunk is a packed bitmap
+    const auto& flags = formatReader.GetRowGroupMeta(0).columns[3];
+    EXPECT_EQ(flags.size, Bitmap::GetWordCount(numRows) * sizeof(uint64_t));
+    EXPECT_EQ(batch.GetColumn(3).GetTypedData<bool>().CountSet(),
+              (numRows + 2) / 3);
+}
+
+TEST_F(FixtureE2E, MappedReaderZeroCopyViews) {
+    std::string data;
+    const size_t numRows = 5000;
+
+    for (size_t i = 1; i <= numRows; ++i) {
+        data += std::to_string(static_cast<int16_t>(Mix(i))) + "," +
+                std::to_string(i * 3) + "," +
+                std::to_string(static_cast<int64_t>(Mix(i + numRows))) +
+                ",s" + std::to_string(i) + "\n";
+    }
+
+    WriteFile(kTestInputDataCsv, data);
+    WriteFile(kTestInputSchemaCsv,
+              "a,int16\n"
+              "b,int32\n"
+              "c,int64\n"
+              "d,string\n");
+
+    Schema schema = Parser::LoadSchemaFromCsv(kTestInputSchemaCsv);
+
+    {
+        IO::CsvReader csvReader(kTestInputDataCsv, schema);
+        IO::FormatWriter formatWriter(kTestIyxFile);
+        formatWriter.Begin(schema);
+
+        while (auto batch = csvReader.ReadBatch()) {
+            formatWriter.WriteRowGroup(RowGroup(std::move(*batch)));
+        }
+
+        formatWriter.End();
+    }
+
+    IO::FormatReader streamReader(kTestIyxFile);
+    streamReader.Open();
+
+    IO::FormatReader mappedReader(kTestIyxFile, {.useMmap = true});
+    mappedReader.Open();
+    ASSERT_EQ(mappedReader.GetRowGroupCount(), streamReader.GetRowGroupCount());
+
+    for (size_t i = 0; i < mappedReader.GetRowGroupCount(); ++i) {
+        RowGroup expected = streamReader.ReadRowGroup(i);
+        const Batch& expectedBatch = expected.GetBatch();
+
+        BatchView view = mappedReader.ReadRowGroupView(i);
+        ASSERT_EQ(view.GetRowCount(), expectedBatch.GetRowCount());
+
+        EXPECT_TRUE(view.GetColumn(0).IsZeroCopy());
+        EXPECT_FALSE(view.GetColumn(1).IsZeroCopy());  // delta encoded
+        EXPECT_EQ(view.GetColumn(2).GetValidity(), nullptr);
+        EXPECT_FALSE(view.GetColumn(3).IsZeroCopy());
+
+        auto c = view.GetColumn(2).GetTypedData<int64_t>();
+        const auto& expectedC =
+            expectedBatch.GetColumn(2).GetTypedData<int64_t>();
+        EXPECT_TRUE(std::equal(c.begin(), c.end(), expectedC.begin(),
+                               expectedC.end()));
+
+        Batch materialized = view.Materialize();
+        for (size_t col = 0; col < schema.GetColumnCount(); ++col) {
+            EXPECT_EQ(materialized.GetColumn(col).GetData(),
+                      expectedBatch.GetColumn(col).GetData());
+        }
+
+        RowGroup mapped = mappedReader.ReadRowGroup(i);
+        EXPECT_EQ(mapped.GetBatch().GetColumn(3).GetData(),
+                  expectedBatch.GetColumn(3).GetData());
+    }
+}
+
+TEST_F(FixtureE2E, ColumnProjection) {
+    std::string data;
+    const size_t numRows = 5000;
+
+    for (size_t i = 1; i <= numRows; ++i) {
+        data += std::to_string(i) + ",name" + std::to_string(i) + "," +
+                (i % 2 == 0 ? "true" : "false") + "," +
+                std::to_string(i * 10) + "\n";
+    }
+
+    WriteFile(kTestInputDataCsv, data);
+    WriteFile(kTestInputSchemaCsv,
+              "id,int64\n"
+              "name,string\n"
+              "even,bool\n"
+              "value,int32\n");
+
+    Schema schema = Parser::LoadSchemaFromCsv(kTestInputSchemaCsv);
+
+    {
+        IO::CsvReader csvReader(kTestInputDataCsv, schema);
+        IO::FormatWriter formatWriter(kTestIyxFile);
+        formatWriter.Begin(schema);
+
+        while (auto batch = csvReader.ReadBatch()) {
+            formatWriter.WriteRowGroup(RowGroup(std::move(*batch)));
+        }
+
+        formatWriter.End();
+    }
+
+    IO::FormatReader fullReader(kTestIyxFile);
+    fullReader.Open();
+
+    IO::FormatReader projectedReader(kTestIyxFile);
+    projectedReader.Open();
+
+    auto projection = projectedReader.GetColumnIndices({"value", "name"});
+    ASSERT_EQ(projection, (std::vector<size_t>{3, 1}));
+
+    size_t rowGroups = 0;
+    while (auto projected = projectedReader.ReadBatch(projection)) {
+        auto full = fullReader.ReadBatch();
+        ASSERT_TRUE(full.has_value());
+
+        ASSERT_EQ(projected->GetColumnCount(), 2);
+        EXPECT_EQ(projected->GetSchema().GetColumn(0).name, "value");
+        EXPECT_EQ(projected->GetSchema().GetColumn(1).name, "name");
+        EXPECT_EQ(projected->GetRowCount(), full->GetRowCount());
+
+        EXPECT_EQ(projected->GetColumn(0).GetData(),
+                  full->GetColumn(3).GetData());
+        EXPECT_EQ(projected->GetColumn(1).GetData(),
+                  full->GetColumn(1).GetData());
+        ++rowGroups;
+    }
+
+    EXPECT_EQ(rowGroups, projectedReader.GetRowGroupCount());
+
+    const RowGroupMeta& meta = projectedReader.GetRowGroupMeta(0);
+    ASSERT_EQ(meta.columns.size(), schema.GetColumnCount());
+    for (size_t i = 1; i < meta.columns.size(); ++i) {
+        EXPECT_GE(meta.columns[i].offset,
+                  meta.columns[i - 1].offset + meta.columns[i - 1].size);
+    }
+}
+
+TEST_F(FixtureE2E, ZoneMapsSkipRowGroups) {
+    std::string data;
+    const size_t numRows = 5000;
+
+    for (size_t i = 1; i <= numRows; ++i) {
+        data += std::to_string(i) + ",k" + std::to_string(i % 10) + "\n";
+    }
+
+    WriteFile(kTestInputDataCsv, data);
+    WriteFile(kTestInputSchemaCsv,
+              "id,int64\n"
+              "key,string\n");
+
+    Schema schema = Parser::LoadSchemaFromCsv(kTestInputSchemaCsv);
+
+    {
+        IO::CsvReader csvReader(kTestInputDataCsv, schema);
+        IO::FormatWriter formatWriter(kTestIyxFile);
+        formatWriter.Begin(schema);
+
+        while (auto batch = csvReader.ReadBatch()) {
+            formatWriter.WriteRowGroup(RowGroup(std::move(*batch)));
+        }
+
+        formatWriter.End();
+    }
+
+    using Op = TStatistics::ECompareOp;
+
+    IO::FormatReader formatReader(kTestIyxFile);
+    formatReader.Open();
+    ASSERT_EQ(formatReader.GetRowGroupCount(), 3);
+
+    const auto& stats = formatReader.GetRowGroupMeta(1).columns[0].statistics;
+    EXPECT_EQ(stats.min_value, TStatistics::TMinMax{int64_t{2049}});
+    EXPECT_EQ(stats.max_value, TStatistics::TMinMax{int64_t{4096}});
+    EXPECT_EQ(stats.nullCount, 0);
+
+    const auto& keyStats =
+        formatReader.GetRowGroupMeta(0).columns[1].statistics;
+    EXPECT_EQ(keyStats.min_value, TStatistics::TMinMax{std::string{"k0"}});
+    EXPECT_EQ(keyStats.max_value, TStatistics::TMinMax{std::string{"k9"}});
+
+    formatReader.AddPredicate("id", Op::GreaterOrEqual, "4500");
+    EXPECT_FALSE(formatReader.RowGroupMayMatch(0));
+    EXPECT_FALSE(formatReader.RowGroupMayMatch(1));
+    EXPECT_TRUE(formatReader.RowGroupMayMatch(2));
+
+    size_t batches = 0;
+    size_t rows = 0;
+    while (auto batch = formatReader.ReadBatch()) {
+        ++batches;
+        rows += batch->GetRowCount();
+    }
+    EXPECT_EQ(batches, 1);
+    EXPECT_EQ(rows, numRows - 4096);
+
+    IO::FormatReader emptyReader(kTestIyxFile);
+    emptyReader.SetPredicates(
+        {{"id", Op::Less, int64_t{1}}, {"key", Op::Equal, std::string{"k5"}}});
+    EXPECT_FALSE(emptyReader.HasMore());
+    EXPECT_FALSE(emptyReader.ReadBatch().has_value());
+
+    EXPECT_THROW(emptyReader.SetPredicates({{"key", Op::Equal, int64_t{5}}}),
+                 std::invalid_argument);
+}
+
+TEST_F(FixtureE2E, IntegerEncodingsRoundTrip) {
+    const size_t numRows = 2000;
+
+    std::vector<int64_t> constant(numRows, -42);
+    std::vector<int32_t> smallRange;
+    std::vector<int64_t> timestamps;
+    std::vector<int16_t> runs;
+    std::vector<int64_t> random;
+    std::vector<int64_t> extremes;
+
+    for (size_t i = 0; i < numRows; ++i) {
+        smallRange.push_back(1'000'000 + static_cast<int32_t>(Mix(i) % 1000));
+        timestamps.push_back(1'700'000'000 + static_cast<int64_t>(i) * 60 +
+                             static_cast<int64_t>(Mix(i) % 3));
+        runs.push_back(static_cast<int16_t>(i / 500 - 2));
+        random.push_back(static_cast<int64_t>(Mix(i)));
+        extremes.push_back(i % 2 == 0 ? std::numeric_limits<int64_t>::min()
+                                      : std::numeric_limits<int64_t>::max());
+    }
+
+    std::vector<Column> columns;
+    columns.push_back(Column::CreateInt64("constant", constant));
+    columns.push_back(Column::CreateInt32("small_range", smallRange));
+    columns.push_back(Column::CreateInt64("timestamps", timestamps));
+    columns.push_back(Column::CreateInt16("runs", runs));
+    columns.push_back(Column::CreateInt64("random", random));
+    columns.push_back(Column::CreateInt64("extremes", extremes));
+    Batch expected(std::move(columns));
+
+    {
+        std::vector<Column> copy(expected.begin(), expected.end());
+        IO::FormatWriter formatWriter(kTestIyxFile);
+        formatWriter.Begin(expected.GetSchema());
+        formatWriter.WriteRowGroup(RowGroup(Batch(std::move(copy))));
+        formatWriter.End();
+    }
+
+    IO::FormatReader formatReader(kTestIyxFile);
+    formatReader.Open();
+
+    using Types::Encoding;
+    const auto& chunks = formatReader.GetRowGroupMeta(0).columns;
+    EXPECT_NE(chunks[0].encoding, Encoding::PLAIN);
+    EXPECT_EQ(chunks[1].encoding, Encoding::BIT_PACKED);
+    EXPECT_EQ(chunks[2].encoding, Encoding::DELTA);
+    EXPECT_EQ(chunks[3].encoding, Encoding::RLE);
+    EXPECT_EQ(chunks[4].encoding, Encoding::PLAIN);
+
+    EXPECT_LT(chunks[1].size, numRows * sizeof(int32_t) / 2);
+    EXPECT_LT(chunks[2].size, numRows * sizeof(int64_t) / 16);
+
+    RowGroup rg = formatReader.ReadRowGroup(0);
+    for (size_t i = 0; i < expected.GetColumnCount(); ++i) {
+        EXPECT_EQ(rg.GetBatch().GetColumn(i).GetData(),
+                  expected.GetColumn(i).GetData())
+            << "Column " << expected.GetColumn(i).GetName() << " mismatch";
+    }
+}
+
+TEST_F(FixtureE2E, DictionaryEncodedStrings) {
+    const std::vector<std::string> countries = {"RU", "US", "DE", "", "FR"};
+    const size_t numRows = 3000;
+
+    std::vector<std::string> country;
+    std::vector<std::string> unique;
+    for (size_t i = 0; i < numRows; ++i) {
+        country.push_back(countries[Mix(i) % countries.size()]);
+        unique.push_back("user_" + std::to_string(Mix(i)));
+    }
+
+    {
+        IO::FormatWriter formatWriter(kTestIyxFile);
+        std::vector<Column> columns;
+        columns.push_back(Column::CreateString("country", country));
+        columns.push_back(Column::CreateString("user", unique));
+        Batch batch(std::move(columns));
+        formatWriter.Begin(batch.GetSchema());
+        formatWriter.WriteRowGroup(RowGroup(std::move(batch)));
+        formatWriter.End();
+    }
+
+    IO::FormatReader formatReader(kTestIyxFile);
+    formatReader.Open();
+
+    const auto& chunks = formatReader.GetRowGroupMeta(0).columns;
+    EXPECT_EQ(chunks[0].encoding, Types::Encoding::DICTIONARY);
+    EXPECT_EQ(chunks[1].encoding, Types::Encoding::PLAIN);
+    EXPECT_LT(chunks[0].size, numRows);
+
+    auto dictionary = formatReader.ReadDictionaryColumn(0, 0);
+    ASSERT_TRUE(dictionary.has_value());
+    EXPECT_EQ(dictionary->name, "country");
+    EXPECT_EQ(dictionary->dictionary.size(), countries.size());
+    ASSERT_EQ(dictionary->GetRowCount(), numRows);
+    for (size_t i = 0; i < numRows; ++i) {
+        ASSERT_EQ(dictionary->dictionary[dictionary->codes[i]], country[i]);
+    }
+
+    EXPECT_FALSE(formatReader.ReadDictionaryColumn(0, 1).has_value());
+
+    RowGroup rg = formatReader.ReadRowGroup(0);
+    EXPECT_EQ(rg.GetBatch().GetColumn(0).GetTypedData<std::string>(),
+              StringVector(country));
+    EXPECT_EQ(rg.GetBatch().GetColumn(1).GetTypedData<std::string>(),
+              StringVector(unique));
+}
+
+TEST_F(FixtureE2E, PrefetchingReaderMatchesDirectReads) {
+    const size_t rowGroups = 7;
+    const size_t rowsPerGroup = 1000;
+
+    {
+        Schema schema;
+        schema.AddColumn({"id", Types::DataType::INT64});
+        schema.AddColumn({"tag", Types::DataType::STRING});
+
+        IO::FormatWriter formatWriter(kTestIyxFile);
+        formatWriter.Begin(schema);
+        for (size_t g = 0; g < rowGroups; ++g) {
+            std::vector<int64_t> ids;
+            std::vector<std::string> tags;
+            for (size_t i = 0; i < rowsPerGroup; ++i) {
+                ids.push_back(static_cast<int64_t>(g * rowsPerGroup + i));
+                tags.push_back("t" + std::to_string(Mix(i) % 1000));
+            }
+
+            std::vector<Column> columns;
+            columns.push_back(Column::CreateInt64("id", std::move(ids)));
+            columns.push_back(Column::CreateString("tag", std::move(tags)));
+            formatWriter.WriteRowGroup(RowGroup(Batch(std::move(columns))));
+        }
+        formatWriter.End();
+    }
+
+    IO::FormatReader direct(kTestIyxFile);
+    direct.Open();
+
+    // depth 1 and a tiny memory cap force the worker to wait on the consumer
+    IO::PrefetchOptions options;
+    options.depth = 1;
+    options.memoryLimit = 1;
+    IO::PrefetchingReader prefetcher(IO::FormatReader(kTestIyxFile), options);
+
+    size_t batches = 0;
+    while (auto batch = prefetcher.ReadBatch()) {
+        auto expected = direct.ReadBatch();
+        ASSERT_TRUE(expected.has_value());
+        for (size_t c = 0; c < expected->GetColumnCount(); ++c) {
+            EXPECT_EQ(batch->GetColumn(c).GetData(),
+                      expected->GetColumn(c).GetData());
+        }
+        ++batches;
+    }
+    EXPECT_EQ(batches, rowGroups);
+    EXPECT_FALSE(direct.HasMore());
+
+    // predicates and projection are applied by the background thread
+    IO::FormatReader filtered(kTestIyxFile);
+    filtered.Open();
+    filtered.AddPredicate("id", TStatistics::ECompareOp::Less, "2500");
+    options.depth = 4;
+    options.projection = {1};
+    IO::PrefetchingReader projected(std::move(filtered), options);
+    ASSERT_EQ(projected.GetSchema().GetColumnCount(), 1);
+
+    size_t rows = 0;
+    while (auto batch = projected.ReadBatch()) {
+        ASSERT_EQ(batch->GetColumnCount(), 1);
+        EXPECT_EQ(batch->GetColumn(0).GetName(), "tag");
+        rows += batch->GetRowCount();
+    }
+    EXPECT_EQ(rows, 3 * rowsPerGroup);
+
+    // destroying a reader with a full queue stops the worker
+    IO::PrefetchingReader abandoned{IO::FormatReader(kTestIyxFile)};
+    EXPECT_TRUE(abandoned.ReadBatch().has_value());
+}
+
+TEST_F(FixtureE2E, BatchedReadsMatchStreamReads) {
+    const size_t rowGroups = 6;
+    const size_t rowsPerGroup = 700;
+
+    {
+        Schema schema;
+        schema.AddColumn({"a", Types::DataType::INT64});
+        schema.AddColumn({"b", Types::DataType::STRING});
+        schema.AddColumn({"c", Types::DataType::INT32});
+
+        IO::FormatWriter formatWriter(kTestIyxFile);
+        formatWriter.Begin(schema);
+        for (size_t g = 0; g < rowGroups; ++g) {
+            std::vector<int64_t> a;
+            std::vector<std::string> b;
+            std::vector<int32_t> c;
+            for (size_t i = 0; i < rowsPerGroup; ++i) {
+                a.push_back(static_cast<int64_t>(Mix(g * rowsPerGroup + i)));
+                b.push_back("value_" + std::to_string(Mix(i) % 97));
+                c.push_back(static_cast<int32_t>(i * g));
+            }
+
+            std::vector<Column> columns;
+            columns.push_back(Column::CreateInt64("a", std::move(a)));
+            columns.push_back(Column::CreateString("b", std::move(b)));
+            columns.push_back(Column::CreateInt32("c", std::move(c)));
+            formatWriter.WriteRowGroup(RowGroup(Batch(std::move(columns))));
+        }
+        formatWriter.End();
+    }
+
+    IO::FormatReader streamReader(kTestIyxFile);
+    streamReader.Open();
+
+    IO::FormatReaderOptions options;
+    options.useIoUring = true;
+    options.ioQueueDepth = 4;
+    IO::FormatReader batchedReader(kTestIyxFile, options);
+    batchedReader.Open();
+    if (!batchedReader.UsesIoUring()) {
+        std::cerr << "io_uring unavailable, checking the fallback path\n";
+    }
+
+    const std::vector<size_t> projection = {2, 0};
+    auto batched =
+        batchedReader.ReadRowGroups({5, 0, 3, 1, 4, 2}, projection);
+    ASSERT_EQ(batched.size(), rowGroups);
+
+    const std::vector<size_t> order = {5, 0, 3, 1, 4, 2};
+    for (size_t i = 0; i < order.size(); ++i) {
+        RowGroup expected = streamReader.ReadRowGroup(order[i], projection);
+        const Batch& batch = batched[i].GetBatch();
+        ASSERT_EQ(batch.GetColumnCount(), 2);
+        for (size_t c = 0; c < 2; ++c) {
+            EXPECT_EQ(batch.GetColumn(c).GetData(),
+                      expected.GetBatch().GetColumn(c).GetData());
+        }
+    }
+
+    // single row group reads take the same backend
+    RowGroup full = batchedReader.ReadRowGroup(3);
+    RowGroup expected = streamReader.ReadRowGroup(3);
+    for (size_t c = 0; c < 3; ++c) {
+        EXPECT_EQ(full.GetBatch().GetColumn(c).GetData(),
+                  expected.GetBatch().GetColumn(c).GetData());
+    }
+}
+
+TEST_F(FixtureE2E, ConcurrentRowGroupReads) {
+    const size_t rowGroups = 16;
+    const size_t rowsPerGroup = 500;
+
+    {
+        Schema schema;
+        schema.AddColumn({"id", Types::DataType::INT64});
+        schema.AddColumn({"name", Types::DataType::STRING});
+
+        IO::FormatWriter formatWriter(kTestIyxFile);
+        formatWriter.Begin(schema);
+        for (size_t g = 0; g < rowGroups; ++g) {
+            std::vector<int64_t> ids;
+            std::vector<std::string> names;
+            for (size_t i = 0; i < rowsPerGroup; ++i) {
+                uint64_t row = g * rowsPerGroup + i;
+                ids.push_back(static_cast<int64_t>(row));
+                names.push_back("n" + std::to_string(Mix(row)));
+            }
+
+            std::vector<Column> columns;
+            columns.push_back(Column::CreateInt64("id", std::move(ids)));
+            columns.push_back(Column::CreateString("name", std::move(names)));
+            formatWriter.WriteRowGroup(RowGroup(Batch(std::move(columns))));
+        }
+        formatWriter.End();
+    }
+
+    IO::FormatReader formatReader(kTestIyxFile);
+    formatReader.Open();
+
+    // every thread reads every row group through the same reader
+    const size_t numThreads = 4;
+    std::vector<size_t> failures(numThreads, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t k = 0; k < rowGroups; ++k) {
+                size_t g = (k + t * 5) % rowGroups;
+                RowGroup rg = formatReader.ReadRowGroup(g);
+                const auto& ids = rg.GetBatch().GetColumn(0);
+                const auto& names = rg.GetBatch().GetColumn(1);
+                for (size_t i = 0; i < rowsPerGroup; ++i) {
+                    uint64_t row = g * rowsPerGroup + i;
+                    if (ids.GetTypedData<int64_t>()[i] !=
+                            static_cast<int64_t>(row) ||
+                        names.GetValueAsString(i) !=
+                            "n" + std::to_string(Mix(row))) {
+                        ++failures[t];
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t t = 0; t < numThreads; ++t) {
+        EXPECT_EQ(failures[t], 0) << "thread " << t;
+    }
+}
+
+TEST_F(FixtureE2E, ParallelWriterMatchesSerialWriter) {
+    const size_t rowGroups = 12;
+    const size_t rowsPerGroup = 1500;
+    const std::string parallelFile = "test_data_parallel.iyx";
+
+    auto makeRowGroup = [](size_t g) {
+        std::vector<int32_t> ids;
+        std::vector<int64_t> values;
+        std::vector<std::string> tags;
+        for (size_t i = 0; i < rowsPerGroup; ++i) {
+            ids.push_back(static_cast<int32_t>(g * rowsPerGroup + i));
+            values.push_back(static_cast<int64_t>(Mix(g * 31 + i) % 5000));
+            tags.push_back(g % 2 == 0 ? "even" : "t" + std::to_string(i));
+        }
+
+        std::vector<Column> columns;
+        columns.push_back(Column::CreateInt32("id", std::move(ids)));
+        columns.push_back(Column::CreateInt64("value", std::move(values)));
+        columns.push_back(Column::CreateString("tag", std::move(tags)));
+        return RowGroup(Batch(std::move(columns)));
+    };
+
+    Schema schema = makeRowGroup(0).GetBatch().GetSchema();
+
+    {
+        IO::FormatWriter serial(kTestIyxFile);
+        serial.Begin(schema);
+        for (size_t g = 0; g < rowGroups; ++g) {
+            serial.WriteRowGroup(makeRowGroup(g));
+        }
+        serial.End();
+    }
+
+    {
+        IO::FormatWriterOptions options;
+        options.encodeThreads = 4;
+        options.maxInFlight = 2;
+        IO::FormatWriter parallel(parallelFile, options);
+        parallel.Begin(schema);
+        for (size_t g = 0; g < rowGroups; ++g) {
+            if (g % 3 == 0) {
+                RowGroup rowGroup = makeRowGroup(g);
+                parallel.WriteRowGroup(rowGroup);  // copied for the worker
+            } else {
+                parallel.WriteRowGroup(makeRowGroup(g));
+            }
+        }
+        parallel.End();
+        EXPECT_EQ(parallel.GetRowGroupCount(), rowGroups);
+        EXPECT_EQ(parallel.GetTotalRowsWritten(), rowGroups * rowsPerGroup);
+    }
+
+    auto readAll = [](const std::string& filename) {
+        std::ifstream input(filename, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(input), {});
+    };
+    EXPECT_EQ(readAll(kTestIyxFile), readAll(parallelFile));
+
+    RemoveFile(parallelFile);
+}
+
+TEST_F(FixtureE2E, ParallelCsvReaderSplitsAtRecordBoundaries) {
+    const size_t numRows = 6000;
+
+    std::string data;
+    std::vector<std::string> expectedNotes;
+    for (size_t i = 0; i < numRows; ++i) {
+        std::string note = "plain" + std::to_string(i);
+        if (i % 7 == 0) {
+            note = "line\nbreak, \"quoted\" " + std::to_string(i);
+        }
+        expectedNotes.push_back(note);
+
+        data += std::to_string(i) + ",";
+        data += note.find_first_of("\n\",") == std::string::npos
+                    ? note
+                    : Parser::EscapeCsvField(note);
+        data += i % 500 == 0 ? "\r\n\n" : "\n";
+    }
+
+    WriteFile(kTestInputDataCsv, data);
+    WriteFile(kTestInputSchemaCsv,
+              "id,int64\n"
+              "note,string\n");
+    Schema schema = Parser::LoadSchemaFromCsv(kTestInputSchemaCsv);
+
+    // tiny ranges put many cuts inside quoted fields
+    IO::ParallelCsvOptions options;
+    options.threads = 4;
+    options.chunkSize = 1000;
+
+    IO::ParallelCsvReader ordered(kTestInputDataCsv, schema, options);
+    size_t row = 0;
+    while (auto batch = ordered.ReadBatch()) {
+        const auto& ids = batch->GetColumn(0).GetTypedData<int64_t>();
+        const auto& notes = batch->GetColumn(1).GetTypedData<std::string>();
+        for (size_t i = 0; i < batch->GetRowCount(); ++i, ++row) {
+            ASSERT_EQ(ids[i], static_cast<int64_t>(row));
+            ASSERT_EQ(notes[i], expectedNotes[row]);
+        }
+    }
+    EXPECT_EQ(row, numRows);
+    EXPECT_EQ(ordered.GetTotalRowsRead(), numRows);
+
+    options.ordered = false;
+    IO::ParallelCsvReader unordered(kTestInputDataCsv, schema, options);
+    std::vector<bool> seen(numRows, false);
+    while (auto batch = unordered.ReadBatch()) {
+        for (int64_t id : batch->GetColumn(0).GetTypedData<int64_t>()) {
+            ASSERT_FALSE(seen[id]);
+            seen[id] = true;
+        }
+    }
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), true), numRows);
+
+    WriteFile(kTestInputDataCsv, "1,ok\n2,\"unclosed\n");
+    IO::ParallelCsvReader broken(kTestInputDataCsv, schema);
+    EXPECT_THROW(
+        {
+            while (broken.ReadBatch()) {
+            }
+        },
+        std::runtime_error);
+}
+
+TEST_F(FixtureE2E, CsvTokenizerRoundTripsEscapedFields) {
+    // random fields with quotes, delimiters and newlines crossing the
+    // 64-byte block boundaries
+    const char alphabet[] = {'a', 'b', ',', '"', '\n', '\r', ' ', 'z'};
+    std::string data;
+    std::vector<std::vector<std::string>> expected;
+    for (size_t row = 0; row < 400; ++row) {
+        size_t fieldCount = 1 + Mix(row) % 5;
+        std::vector<std::string> fields;
+        for (size_t f = 0; f < fieldCount; ++f) {
+            std::string field;
+            size_t length = Mix(row * 7 + f) % 90;
+            for (size_t i = 0; i < length; ++i) {
+                field += alphabet[Mix(row * 1000 + f * 100 + i) % 8];
+            }
+            fields.push_back(field);
+        }
+        data += Parser::MergeFieldsInLine(fields);
+        data += row % 3 == 0 ? "\r\n" : "\n";
+        expected.push_back(std::move(fields));
+    }
+    data += "last,record";
+    expected.push_back({"last", "record"});
+
+    std::vector<Parser::CsvTokenizerIsa> isas = {
+        Parser::CsvTokenizerIsa::SCALAR};
+    if (Parser::GetCsvTokenizerIsa() != Parser::CsvTokenizerIsa::SCALAR) {
+        isas.push_back(Parser::CsvTokenizerIsa::SSE2);
+    }
+    if (Parser::GetCsvTokenizerIsa() == Parser::CsvTokenizerIsa::AVX2) {
+        isas.push_back(Parser::CsvTokenizerIsa::AVX2);
+    }
+
+    for (auto isa : isas) {
+        Parser::CsvTokens tokens;
+        Parser::TokenizeCsv(data, tokens, {}, isa);
+        ASSERT_EQ(tokens.GetRecordCount(), expected.size());
+
+        std::string scratch;
+        size_t field = 0;
+        for (size_t r = 0; r < expected.size(); ++r) {
+            ASSERT_EQ(tokens.recordEnds[r] - field, expected[r].size());
+            for (const auto& value : expected[r]) {
+                size_t begin = tokens.GetFieldBegin(field);
+                std::string_view raw(data.data() + begin,
+                                     tokens.fieldEnds[field] - begin);
+                ASSERT_EQ(Parser::UnescapeCsvField(raw, scratch), value)
+                    << "record " << r << ", isa " << static_cast<int>(isa);
+                ++field;
+            }
+        }
+
+        EXPECT_THROW(Parser::TokenizeCsv("a,\"b\n", tokens, {}, isa),
+                     std::runtime_error);
+    }
+}
+
+TEST_F(FixtureE2E, TypedCsvAppendMatchesValueParser) {
+    std::vector<std::vector<std::string>> rows;
+    for (size_t i = 0; i < 5000; ++i) {
+        rows.push_back({
+            std::to_string(static_cast<int16_t>(Mix(i))),
+            " " + std::to_string(static_cast<int32_t>(Mix(i + 1))) + " ",
+            std::to_string(static_cast<int64_t>(Mix(i + 2))),
+            i % 3 == 0 ? "TRUE" : (i % 3 == 1 ? " false" : "True"),
+            i % 4 == 0 ? "say \"hi\", " + std::to_string(i)
+                       : "s" + std::to_string(i),
+            "20" + std::to_string(10 + i % 20) + "-0" +
+                std::to_string(1 + i % 9) + "-1" + std::to_string(i % 10),
+        });
+    }
+
+    std::string data;
+    for (const auto& row : rows) {
+        data += Parser::MergeFieldsInLine(row) + "\n";
+    }
+    WriteFile(kTestInputDataCsv, data);
+    WriteFile(kTestInputSchemaCsv,
+              "a,int16\nb,int32\nc,int64\nd,bool\ne,string\nf,date\n");
+    Schema schema = Parser::LoadSchemaFromCsv(kTestInputSchemaCsv);
+
+    Batch expected = Batch::CreateEmpty(schema);
+    for (const auto& row : rows) {
+        for (size_t c = 0; c < row.size(); ++c) {
+            expected.GetMutableColumn(c).AppendFromString(std::string(row[c]));
+        }
+    }
+
+    auto check = [&](auto& reader) {
+        size_t offset = 0;
+        while (auto batch = reader.ReadBatch()) {
+            for (size_t c = 0; c < schema.GetColumnCount(); ++c) {
+                for (size_t r = 0; r < batch->GetRowCount(); ++r) {
+                    ASSERT_EQ(batch->GetColumn(c).GetValueAsString(r),
+                              expected.GetColumn(c).GetValueAsString(offset +
+                                                                     r));
+                }
+            }
+            offset += batch->GetRowCount();
+        }
+        EXPECT_EQ(offset, rows.size());
+    };
+
+    IO::CsvReader csvReader(kTestInputDataCsv, schema);
+    check(csvReader);
+
+    IO::ParallelCsvOptions options;
+    options.threads = 3;
+    options.chunkSize = 4096;
+    IO::ParallelCsvReader parallelReader(kTestInputDataCsv, schema, options);
+    check(parallelReader);
+
+    WriteFile(kTestInputDataCsv, "1,2,3,true,x,2020-01-01\n1,2,oops,true,x,"
+                                 "2020-01-01\n");
+    IO::CsvReader broken(kTestInputDataCsv, schema);
+    EXPECT_THROW(broken.ReadBatch(), std::invalid_argument);
+}
+
+TEST_F(FixtureE2E, DateTimestampCivilArithmetic) {
+    EXPECT_EQ(Parser::ParseDate("1970-01-01"), 0);
+    EXPECT_EQ(Parser::ParseDate(" 2000-03-01 "), 11017);
+    EXPECT_EQ(Parser::ParseDate("1969-12-31"), -1);
+    EXPECT_EQ(Parser::ParseDate("0000-03-01"), -719468);
+    EXPECT_EQ(Parser::ParseTimestamp("2023-11-14 22:13:20"), 1'700'000'000);
+    EXPECT_EQ(Parser::ParseTimestamp("2023-11-14T22:13:20"), 1'700'000'000);
+    EXPECT_EQ(Parser::ParseTimestamp("1969-12-31 23:59:59"), -1);
+
+    EXPECT_EQ(Parser::FormatDate(0), "1970-01-01");
+    EXPECT_EQ(Parser::FormatDate(11016), "2000-02-29");
+    EXPECT_EQ(Parser::FormatTimestamp(-1), "1969-12-31 23:59:59");
+    EXPECT_EQ(Parser::FormatTimestamp(1'700'000'000), "2023-11-14 22:13:20");
+    EXPECT_THROW(Parser::FormatDate(Parser::DaysFromCivil(10000, 1, 1)),
+                 std::out_of_range);
+
+    for (int32_t days = -719'528; days <= 2'932'896; days += 7) {
+        std::string text = Parser::FormatDate(days);
+        ASSERT_EQ(Parser::ParseDate(text), days) << text;
+
+        int64_t seconds = static_cast<int64_t>(days) * 86400 +
+                          static_cast<int64_t>(Mix(days) % 86400);
+        ASSERT_EQ(Parser::ParseTimestamp(Parser::FormatTimestamp(seconds)),
+                  seconds);
+    }
+
+    for (const char* bad :
+         {"", "2020-1-01", "2020-13-01", "2021-02-29", "2020-00-10",
+          "2020-01-32", "2020/01/01", "20a0-01-01", "2020-01-0x",
+          "2020-01-01x"}) {
+        EXPECT_THROW(Parser::ParseDate(bad), std::invalid_argument) << bad;
+    }
+    for (const char* bad :
+         {"2020-01-01", "2020-01-01 24:00:00", "2020-01-01 12:60:00",
+          "2020-01-01 12:00:60", "2020-01-01_12:00:00",
+          "2020-01-01 12-00-00", "2020-01-01 1a:00:00"}) {
+        EXPECT_THROW(Parser::ParseTimestamp(bad), std::invalid_argument)
+            << bad;
+    }
+
+    Column column("d", Types::DataType::DATE);
+    column.AppendFromString("2024-02-29");
+    EXPECT_EQ(column.GetValueAsString(0), "2024-02-29");
+}
+
+TEST_F(FixtureE2E, CsvWriterMatchesRowFormatting) {
+    WriteFile(kTestInputSchemaCsv, "a,int16\nb,int64\nc,bool\nd,string\n"
+                                   "e,date\nf,timestamp\n");
+    Schema schema = Parser::LoadSchemaFromCsv(kTestInputSchemaCsv);
+
+    const std::vector<std::string> strings = {
+        "plain", "", "with,comma", "with \"quote\"", "multi\nline", "cr\r"};
+
+    std::vector<Batch> batches;
+    std::string expected;
+    for (size_t b = 0; b < 3; ++b) {
+        Batch batch = Batch::CreateEmpty(schema);
+        for (size_t i = 0; i < 200; ++i) {
+            uint64_t r = Mix(b * 1000 + i);
+            std::vector<std::string> row = {
+                std::to_string(static_cast<int16_t>(r)),
+                std::to_string(static_cast<int64_t>(r)),
+                r % 3 == 0 ? "true" : "false",
+                // the second batch has no strings that need quoting
+                b == 1 ? strings[r % 2] : strings[r % strings.size()],
+                Parser::FormatDate(static_cast<int32_t>(r % 20000)),
+                Parser::FormatTimestamp(
+                    static_cast<int64_t>(r % 2'000'000'000)),
+            };
+            expected += Parser::MergeFieldsInLine(row) + "\n";
+            ASSERT_TRUE(batch.AppendRow(std::move(row)));
+        }
+        batches.push_back(std::move(batch));
+    }
+
+    IO::CsvWriterOptions options;
+    options.bufferSize = 64;  // smaller than some rows
+    {
+        IO::CsvWriter writer(kTestOutputDataCsv, options);
+        for (const auto& batch : batches) {
+            writer.WriteBatch(batch);
+        }
+        EXPECT_EQ(writer.GetRowsWritten(), 600);
+    }
+
+    std::ifstream file(kTestOutputDataCsv, std::ios::binary);
+    std::string actual((std::istreambuf_iterator<char>(file)),
+                       std::istreambuf_iterator<char>());
+    EXPECT_EQ(actual, expected);
+}
+
+TEST_F(FixtureE2E, ParallelCsvExportKeepsRowGroupOrder) {
+    const size_t rowGroupCount = 7;
+    const std::vector<std::string> parts = {"export.0.csv", "export.1.csv",
+                                            "export.2.csv"};
+
+    std::string expected;
+    {
+        IO::FormatWriter formatWriter(kTestIyxFile);
+        IO::CsvFormatter formatter;
+        std::vector<char> text;
+        for (size_t g = 0; g < rowGroupCount; ++g) {
+            std::vector<int32_t> ids;
+            std::vector<std::string> names;
+            for (size_t i = 0; i < 100 + g * 37; ++i) {
+                ids.push_back(static_cast<int32_t>(g * 1000 + i));
+                names.push_back(i % 5 == 0 ? "a,\"b\""
+                                           : std::to_string(Mix(i) % 100));
+            }
+
+            std::vector<Column> columns;
+            columns.push_back(Column::CreateInt32("id", ids));
+            columns.push_back(Column::CreateString("name", names));
+            Batch batch(std::move(columns));
+            if (g == 0) {
+                formatWriter.Begin(batch.GetSchema());
+            }
+            formatter.Format(batch, text);
+            formatWriter.WriteRowGroup(RowGroup(std::move(batch)));
+        }
+        formatWriter.End();
+        expected.assign(text.begin(), text.end());
+    }
+
+    IO::FormatReader reader(kTestIyxFile);
+    reader.Open();
+
+    IO::CsvExportOptions options;
+    options.threads = 3;
+    options.maxInFlight = 2;
+    std::vector<size_t> order;
+    options.onRowGroupWritten = [&order](size_t index, size_t) {
+        order.push_back(index);
+    };
+
+    EXPECT_EQ(IO::ExportCsv(reader, {kTestOutputDataCsv}, options),
+              reader.GetTotalRowCount());
+    std::ifstream single(kTestOutputDataCsv, std::ios::binary);
+    EXPECT_EQ(std::string(std::istreambuf_iterator<char>(single), {}),
+              expected);
+    EXPECT_TRUE(std::is_sorted(order.begin(), order.end()));
+    EXPECT_EQ(order.size(), rowGroupCount);
+
+    EXPECT_EQ(IO::ExportCsv(reader, parts, options),
+              reader.GetTotalRowCount());
+    std::string joined;
+    for (const auto& part : parts) {
+        std::ifstream file(part, std::ios::binary);
+        std::string text(std::istreambuf_iterator<char>(file), {});
+        EXPECT_FALSE(text.empty()) << part;
+        joined += text;
+        RemoveFile(part);
+    }
+    EXPECT_EQ(joined, expected);
+}
+
+TEST_F(FixtureE2E, GermanStringsCompareLikeStrings) {
+    std::vector<std::string> values = {"",     "a",    "ab",   "abc",
+                                       "abcd", "abce", "a\xff"};
+    values.push_back(std::string("ab\0", 3));
+    for (size_t i = 0; i < 300; ++i) {
+        std::string value(Mix(i) % 40, 'x');
+        for (size_t j = 0; j < value.size(); ++j) {
+            value[j] = static_cast<char>('a' + Mix(i * 64 + j) % 3);
+        }
+        values.push_back(value);
+    }
+
+    GermanStringVector strings(StringVector{values});
+    ASSERT_EQ(strings.size(), values.size());
+    EXPECT_GT(strings.GetArenaSize(), 0);
+
+    // copies own their arena
+    GermanStringVector copy;
+    {
+        GermanStringVector temporary(strings);
+        copy = temporary;
+    }
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(copy[i].view(), values[i]);
+        EXPECT_EQ(copy[i].IsInline(), values[i].size() <= 12);
+
+        for (size_t j = 0; j < values.size(); ++j) {
+            ASSERT_EQ(strings[i] == copy[j], values[i] == values[j])
+                << i << " " << j;
+            ASSERT_EQ(strings[i] <=> copy[j], values[i] <=> values[j])
+                << i << " " << j;
+        }
+
+        for (size_t length = 0; length <= values[i].size() + 1; ++length) {
+            std::string prefix =
+                values[(i * 7) % values.size()].substr(0, length);
+            ASSERT_EQ(strings[i].StartsWith(prefix),
+                      values[i].starts_with(prefix));
+            ASSERT_TRUE(strings[i].StartsWith(values[i].substr(0, length)));
+        }
+    }
+
+    // moved-from vectors drop their arena cursor, appends do not touch the
+    // block now owned by the target
+    GermanStringVector moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(copy.GetArenaSize(), 0);
+    copy.push_back(std::string(100, 'q'));
+    ASSERT_EQ(copy.size(), 1);
+    EXPECT_EQ(copy[0].view(), std::string(100, 'q'));
+    EXPECT_EQ(copy.GetArenaSize(), 100);
+
+    GermanStringVector assigned;
+    assigned = std::move(copy);
+    EXPECT_TRUE(copy.empty());
+    copy.push_back(std::string(50, 'r'));
+    EXPECT_EQ(copy[0].view(), std::string(50, 'r'));
+    EXPECT_EQ(assigned[0].view(), std::string(100, 'q'));
+    moved.push_back(std::string(30, 's'));
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(moved[i].view(), values[i]);
+    }
+    EXPECT_EQ(moved[values.size()].view(), std::string(30, 's'));
+}
+
+TEST_F(FixtureE2E, NullsRoundTripThroughCsvAndIyx) {
+    WriteFile(kTestInputSchemaCsv, "id,int32\nflag,bool\nday,date\n"
+                                   "name,string\n");
+    std::string data;
+    for (size_t i = 0; i < 3000; ++i) {
+        data += i % 3 == 0 ? "" : std::to_string(i);
+        data += i % 5 == 0 ? "," : (i % 2 == 0 ? ",true" : ",false");
+        data += ",2024-01-01,";
+        data += i % 4 == 0 ? "RU" : "US";
+        data += "\n";
+    }
+    WriteFile(kTestInputDataCsv, data);
+    Schema schema = Parser::LoadSchemaFromCsv(kTestInputSchemaCsv);
+
+    std::vector<std::vector<std::string>> rows;
+    IO::CsvReader csvReader(kTestInputDataCsv, schema);
+    {
+        IO::FormatWriter writer(kTestIyxFile);
+        writer.Begin(schema);
+        while (auto batch = csvReader.ReadBatch()) {
+            // strings are never NULL in CSV, set some by hand
+            for (size_t r = 0; r < batch->GetRowCount(); r += 7) {
+                batch->GetMutableColumn(3).SetNull(r);
+            }
+            // a present but all-set validity has no NULLs to write
+            Column& day = batch->GetMutableColumn(2);
+            day.SetNull(0);
+            day.GetMutableValidity().Set(0, true);
+            ASSERT_NE(day.GetValidity(), nullptr);
+            for (size_t r = 0; r < batch->GetRowCount(); ++r) {
+                std::vector<std::string> row;
+                for (const auto& column : *batch) {
+                    row.push_back(column.GetValueAsString(r));
+                }
+                rows.push_back(std::move(row));
+            }
+            writer.WriteRowGroup(RowGroup(std::move(*batch)));
+        }
+        writer.End();
+    }
+
+    IO::FormatReader reader(kTestIyxFile);
+    reader.Open();
+    const auto& chunks = reader.GetRowGroupMeta(0).columns;
+    EXPECT_EQ(chunks[0].statistics.nullCount, 683);
+    EXPECT_EQ(chunks[1].statistics.nullCount, 410);
+    EXPECT_EQ(chunks[2].statistics.nullCount, 0);
+    EXPECT_EQ(chunks[3].statistics.nullCount, 293);
+    EXPECT_EQ(chunks[3].encoding, Types::Encoding::DICTIONARY);
+    EXPECT_EQ(std::get<int32_t>(chunks[0].statistics.min_value), 1);
+
+    RowGroup rg = reader.ReadRowGroup(0);
+    const Batch& batch = rg.GetBatch();
+    EXPECT_EQ(batch.GetColumn(0).GetNullCount(), 683);
+    EXPECT_EQ(batch.GetColumn(2).GetValidity(), nullptr);
+    for (size_t r = 0; r < batch.GetRowCount(); ++r) {
+        ASSERT_EQ(batch.GetColumn(0).IsNull(r), r % 3 == 0) << r;
+        ASSERT_EQ(batch.GetColumn(1).IsNull(r), r % 5 == 0) << r;
+        ASSERT_EQ(batch.GetColumn(3).IsNull(r), r % 2048 % 7 == 0) << r;
+    }
+
+    BatchView view = reader.ReadRowGroupView(0);
+    EXPECT_FALSE(view.GetColumn(0).IsZeroCopy());
+    EXPECT_EQ(view.GetColumn(2).GetValidity(), nullptr);
+    EXPECT_EQ(*view.GetColumn(0).GetValidity(),
+              *batch.GetColumn(0).GetValidity());
+
+    auto dictionary = reader.ReadDictionaryColumn(0, 3);
+    ASSERT_TRUE(dictionary.has_value());
+    EXPECT_EQ(*dictionary->Materialize().GetValidity(),
+              *batch.GetColumn(3).GetValidity());
+
+    // NULLs are written as empty fields and read back as NULLs
+    {
+        IO::CsvWriter csvWriter(kTestOutputDataCsv);
+        while (auto next = reader.ReadBatch()) {
+            csvWriter.WriteBatch(*next);
+        }
+    }
+    IO::CsvReader again(kTestOutputDataCsv, schema);
+    size_t offset = 0;
+    while (auto next = again.ReadBatch()) {
+        for (size_t r = 0; r < next->GetRowCount(); ++r) {
+            const auto& row = rows[offset + r];
+            for (size_t c = 0; c < 3; ++c) {
+                ASSERT_EQ(next->GetColumn(c).IsNull(r), row[c].empty());
+                ASSERT_EQ(next->GetColumn(c).GetValueAsString(r), row[c]);
+            }
+        }
+        offset += next->GetRowCount();
+    }
+    EXPECT_EQ(offset, rows.size());
+}
+
+TEST_F(FixtureE2E, SelectionVectorsAvoidCopies) {
+    const size_t numRows = 1000;
+    std::vector<int64_t> ids;
+    std::vector<std::string> names;
+    std::vector<bool> flags;
+    Bitmap mask;
+    for (size_t i = 0; i < numRows; ++i) {
+        ids.push_back(static_cast<int64_t>(Mix(i)));
+        names.push_back("name" + std::to_string(i % 17));
+        flags.push_back(i % 3 == 0);
+        mask.push_back(Mix(i) % 10 == 0);
+    }
+
+    std::vector<Column> columns;
+    columns.push_back(Column::CreateInt64("id", ids));
+    columns.push_back(Column::CreateString("name", names));
+    columns.push_back(Column::CreateBool("flag", flags));
+    columns[0].SetNull(4);
+    Batch batch(std::move(columns));
+
+    EXPECT_THROW(batch.SetSelection({3, 2}), std::invalid_argument);
+    EXPECT_THROW(batch.SetSelection({1000}), std::out_of_range);
+    EXPECT_THROW(batch.SetSelectionMask(Bitmap(5)), std::invalid_argument);
+
+    batch.SetSelectionMask(mask);
+    const std::vector<uint32_t> selected = *batch.GetSelection();
+    EXPECT_EQ(batch.GetSelectedRowCount(), mask.CountSet());
+    EXPECT_EQ(batch.GetRowCount(), numRows);
+    EXPECT_THROW(batch.AppendRow({"1", "x", "true"}), std::logic_error);
+
+    Batch compacted = batch.GetCompacted();
+    ASSERT_EQ(compacted.GetRowCount(), selected.size());
+    EXPECT_FALSE(compacted.HasSelection());
+    for (size_t i = 0; i < selected.size(); ++i) {
+        for (size_t c = 0; c < batch.GetColumnCount(); ++c) {
+            ASSERT_EQ(compacted.GetColumn(c).GetValueAsString(i),
+                      batch.GetColumn(c).GetValueAsString(selected[i]));
+            ASSERT_EQ(compacted.GetColumn(c).IsNull(i),
+                      batch.GetColumn(c).IsNull(selected[i]));
+        }
+    }
+
+    // writers honor the selection
+    {
+        IO::CsvWriter selectedWriter(kTestOutputDataCsv);
+        selectedWriter.WriteBatch(batch);
+        EXPECT_EQ(selectedWriter.GetRowsWritten(), selected.size());
+    }
+    std::vector<char> expected;
+    IO::CsvFormatter().Format(compacted, expected);
+    std::ifstream csv(kTestOutputDataCsv, std::ios::binary);
+    EXPECT_EQ(std::string(std::istreambuf_iterator<char>(csv), {}),
+              std::string(expected.begin(), expected.end()));
+
+    {
+        IO::FormatWriter writer(kTestIyxFile);
+        writer.Begin(batch.GetSchema());
+        writer.WriteRowGroup(RowGroup(std::move(batch)));
+        writer.End();
+    }
+    IO::FormatReader reader(kTestIyxFile);
+    reader.Open();
+    RowGroup rg = reader.ReadRowGroup(0);
+    ASSERT_EQ(rg.GetBatch().GetRowCount(), selected.size());
+    for (size_t c = 0; c < compacted.GetColumnCount(); ++c) {
+        EXPECT_EQ(rg.GetBatch().GetColumn(c).GetData(),
+                  compacted.GetColumn(c).GetData());
+    }
+
+    // dense selections stay in place, sparse ones are compacted
+    Batch dense = compacted.GetCompacted();
+    dense.SetSelectionMask(Bitmap(dense.GetRowCount(), true));
+    dense.CompactIfSparse();
+    EXPECT_TRUE(dense.HasSelection());
+    dense.SetSelection({0, 5});
+    dense.CompactIfSparse();
+    EXPECT_FALSE(dense.HasSelection());
+    EXPECT_EQ(dense.GetRowCount(), 2);
+}
+
+TEST_F(FixtureE2E, FilterKernelsMatchScalarComparisons) {
+    using Compute::ECompareOp;
+    using Compute::FilterIsa;
+
+    // not a multiple of the 64-row block, so every kernel has a tail
+    const size_t numRows = 1000;
+    std::vector<int16_t> small;
+    std::vector<int32_t> medium;
+    std::vector<int64_t> large;
+    std::vector<int64_t> other;
+    for (size_t i = 0; i < numRows; ++i) {
+        // narrow range so that equality matches often
+        int64_t value = static_cast<int64_t>(Mix(i) % 41) - 20;
+        small.push_back(static_cast<int16_t>(value));
+        medium.push_back(static_cast<int32_t>(value * 100000));
+        large.push_back(value << 40);
+        other.push_back(static_cast<int64_t>(Mix(i + numRows) % 41) - 20);
+    }
+
+    const std::vector<ECompareOp> ops = {
+        ECompareOp::Equal,   ECompareOp::NotEqual,
+        ECompareOp::Less,    ECompareOp::LessOrEqual,
+        ECompareOp::Greater, ECompareOp::GreaterOrEqual};
+    auto compare = [](int64_t a, ECompareOp op, int64_t b) {
+        switch (op) {
+            case ECompareOp::Equal:
+                return a == b;
+            case ECompareOp::NotEqual:
+                return a != b;
+            case ECompareOp::Less:
+                return a < b;
+            case ECompareOp::LessOrEqual:
+                return a <= b;
+            case ECompareOp::Greater:
+                return a > b;
+            case ECompareOp::GreaterOrEqual:
+                return a >= b;
+        }
+        return false;
+    };
+
+    Column smallColumn = Column::CreateInt16("small", small);
+    Column mediumColumn = Column::CreateInt32("medium", medium);
+    Column largeColumn = Column::CreateInt64("large", large);
+    Column otherColumn = Column::CreateInt64("other", other);
+
+    std::vector<FilterIsa> isas = {FilterIsa::SCALAR};
+    if (Compute::GetFilterIsa() >= FilterIsa::AVX2) {
+        isas.push_back(FilterIsa::AVX2);
+    }
+    if (Compute::GetFilterIsa() >= FilterIsa::AVX512) {
+        isas.push_back(FilterIsa::AVX512);
+    }
+
+    for (FilterIsa isa : isas) {
+        for (ECompareOp op : ops) {
+            Bitmap bySmall =
+                Compute::CompareConstant(smallColumn, op, int16_t{3}, isa);
+            Bitmap byMedium = Compute::CompareConstant(
+                mediumColumn, op, int32_t{300000}, isa);
+            Bitmap byLarge = Compute::CompareConstant(
+                largeColumn, op, int64_t{3} << 40, isa);
+            Bitmap byColumn =
+                Compute::CompareColumns(smallColumn, op, otherColumn, isa);
+            ASSERT_EQ(bySmall.size(), numRows);
+            ASSERT_EQ(byColumn.size(), numRows);
+            for (size_t i = 0; i < numRows; ++i) {
+                bool expected = compare(small[i], op, 3);
+                ASSERT_EQ(bySmall[i], expected) << i;
+                ASSERT_EQ(byMedium[i], expected) << i;
+                ASSERT_EQ(byLarge[i], expected) << i;
+                ASSERT_EQ(byColumn[i], compare(small[i], op, other[i])) << i;
+            }
+
+            // constants outside the column type match all rows or none
+            Bitmap above = Compute::CompareConstant(
+                smallColumn, op, int64_t{1} << 20, isa);
+            EXPECT_EQ(above.CountSet(),
+                      compare(0, op, 1) ? numRows : size_t{0});
+        }
+    }
+    EXPECT_THROW(Compute::CompareConstant(smallColumn, ECompareOp::Equal,
+                                          std::string("x")),
+                 std::invalid_argument);
+    EXPECT_THROW(Compute::CompareColumns(smallColumn, ECompareOp::Equal,
+                                         Column::CreateInt16("short", {1})),
+                 std::invalid_argument);
+
+    // DATE counts days and TIMESTAMP seconds, neither widens to the other
+    // or to a plain integer
+    Column days("day", Types::DataType::DATE,
+                std::vector<int32_t>{0, 1, 19000});
+    Column seconds("at", Types::DataType::TIMESTAMP,
+                   std::vector<int64_t>{0, 1, 19000});
+    Column numbers = Column::CreateInt32("n", {0, 1, 19000});
+    EXPECT_THROW(Compute::CompareColumns(days, ECompareOp::Equal, seconds),
+                 std::invalid_argument);
+    EXPECT_THROW(Compute::CompareColumns(numbers, ECompareOp::Equal, days),
+                 std::invalid_argument);
+    EXPECT_EQ(Compute::CompareColumns(days, ECompareOp::Equal, days),
+              Bitmap({true, true, true}));
+
+    // strings and bools are compared by value, NULL rows never match
+    Column names = Column::CreateString(
+        "name", std::vector<std::string>{"apple", "pear", "fig", "pear"});
+    Column flags = Column::CreateBool(
+        "flag", std::vector<bool>{true, false, true, true});
+    names.SetNull(1);
+    EXPECT_EQ(Compute::CompareConstant(names, ECompareOp::GreaterOrEqual,
+                                       std::string("fig")),
+              Bitmap({false, false, true, true}));
+    EXPECT_EQ(Compute::CompareConstant(flags, ECompareOp::Less, true),
+              Bitmap({false, true, false, false}));
+
+    // filters narrow an existing selection without copying columns
+    std::vector<Column> columns;
+    columns.push_back(Column::CreateInt16("small", small));
+    columns.push_back(Column::CreateInt64("large", large));
+    Batch batch(std::move(columns));
+    Compute::FilterBatch(batch, 0, ECompareOp::Greater, int16_t{0});
+    Compute::FilterBatch(batch, 1, ECompareOp::Less, int64_t{10} << 40);
+    std::vector<uint32_t> expected;
+    for (size_t i = 0; i < numRows; ++i) {
+        if (small[i] > 0 && small[i] < 10) {
+            expected.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    ASSERT_NE(batch.GetSelection(), nullptr);
+    EXPECT_EQ(*batch.GetSelection(), expected);
+    EXPECT_EQ(batch.GetRowCount(), numRows);
+}
+
+TEST_F(FixtureE2E, AggregatesMatchScalarReduction) {
+    using Compute::FilterIsa;
+    using Compute::Int128;
+
+    const size_t numRows = 1000;
+    std::vector<int16_t> small;
+    std::vector<int32_t> medium;
+    std::vector<int64_t> large;
+    Bitmap mask;
+    for (size_t i = 0; i < numRows; ++i) {
+        small.push_back(static_cast<int16_t>(Mix(i)));
+        medium.push_back(static_cast<int32_t>(Mix(i)));
+        // near the int64 limits, so the sum overflows 64 bits
+        int64_t big = static_cast<int64_t>((Mix(i) >> 3) | (uint64_t{3} << 61));
+        large.push_back(i % 4 == 0 ? -big : big);
+        // whole selected 64-row blocks mixed with sparse ones
+        mask.push_back((i / 64) % 3 != 0 || i % 5 == 0);
+    }
+
+    std::vector<Column> columns;
+    columns.push_back(Column::CreateInt16("small", small));
+    columns.push_back(Column::CreateInt32("medium", medium));
+    columns.push_back(Column::CreateInt64("large", large));
+    for (size_t i = 0; i < numRows; i += 7) {
+        columns[2].SetNull(i);
+    }
+
+    std::vector<FilterIsa> isas = {FilterIsa::SCALAR};
+    if (Compute::GetFilterIsa() >= FilterIsa::AVX2) {
+        isas.push_back(FilterIsa::AVX2);
+    }
+    if (Compute::GetFilterIsa() >= FilterIsa::AVX512) {
+        isas.push_back(FilterIsa::AVX512);
+    }
+
+    for (const Column& column : columns) {
+        for (const Bitmap* rows : {static_cast<const Bitmap*>(nullptr),
+                                   static_cast<const Bitmap*>(&mask)}) {
+            size_t count = 0;
+            Int128 sum = 0;
+            int64_t min = std::numeric_limits<int64_t>::max();
+            int64_t max = std::numeric_limits<int64_t>::min();
+            for (size_t i = 0; i < numRows; ++i) {
+                if (column.IsNull(i) || (rows && !(*rows)[i])) {
+                    continue;
+                }
+                int64_t value = std::stoll(column.GetValueAsString(i));
+                ++count;
+                sum += value;
+                min = std::min(min, value);
+                max = std::max(max, value);
+            }
+
+            for (FilterIsa isa : isas) {
+                Compute::AggregateResult result =
+                    Compute::Aggregate(column, rows, isa);
+                ASSERT_EQ(result.count, count) << column.GetName();
+                ASSERT_TRUE(result.sum == sum) << column.GetName();
+                EXPECT_EQ(CompareMinMax(result.min, int64_t{min}), 0);
+                EXPECT_EQ(CompareMinMax(result.max, int64_t{max}), 0);
+                EXPECT_DOUBLE_EQ(*result.GetAverage(),
+                                 static_cast<double>(sum) /
+                                     static_cast<double>(count));
+            }
+        }
+    }
+    Bitmap shortMask(3);
+    EXPECT_THROW(Compute::Aggregate(columns[0], &shortMask),
+                 std::invalid_argument);
+
+    // bools count true values, strings only have min and max
+    Column flags = Column::CreateBool(
+        "flag", std::vector<bool>{true, false, true, true});
+    Column names = Column::CreateString(
+        "name", std::vector<std::string>{"pear", "apple", "fig", "plum"});
+    flags.SetNull(1);
+    names.SetNull(3);
+    Compute::AggregateResult byFlag = Compute::Aggregate(flags);
+    EXPECT_EQ(byFlag.count, 3);
+    EXPECT_TRUE(byFlag.sum == 3);
+    EXPECT_EQ(byFlag.min, TStatistics::TMinMax(true));
+    Compute::AggregateResult byName = Compute::Aggregate(names);
+    EXPECT_EQ(byName.count, 3);
+    EXPECT_EQ(byName.min, TStatistics::TMinMax(std::string("apple")));
+    EXPECT_EQ(byName.max, TStatistics::TMinMax(std::string("pear")));
+
+    Bitmap noRows(numRows);
+    Compute::AggregateResult empty = Compute::Aggregate(columns[0], &noRows);
+    EXPECT_EQ(empty.count, 0);
+    EXPECT_FALSE(empty.GetAverage());
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(empty.min));
+
+    // batches aggregate their selected rows
+    Batch batch(std::move(columns));
+    Compute::FilterBatch(batch, 0, Compute::ECompareOp::Less, int16_t{0});
+    Compute::AggregateResult selected = Compute::Aggregate(batch, 1);
+    Int128 expectedSum = 0;
+    size_t expectedCount = 0;
+    for (size_t i = 0; i < numRows; ++i) {
+        if (small[i] < 0) {
+            expectedSum += medium[i];
+            ++expectedCount;
+        }
+    }
+    EXPECT_EQ(selected.count, expectedCount);
+    EXPECT_TRUE(selected.sum == expectedSum);
+}
+
+TEST_F(FixtureE2E, HashGroupByMatchesReference) {
+    using Compute::AggregateFunction;
+
+    const size_t numBatches = 3;
+    const size_t rowsPerBatch = 2000;
+    Schema schema;
+    schema.AddColumn({"user", Types::DataType::INT32});
+    schema.AddColumn({"country", Types::DataType::STRING});
+    schema.AddColumn({"flag", Types::DataType::BOOL});
+    schema.AddColumn({"amount", Types::DataType::INT64});
+
+    // every batch keeps the rows with Mix(row) % 4 != 0 through a selection
+    std::vector<Batch> batches;
+    for (size_t b = 0; b < numBatches; ++b) {
+        std::vector<int32_t> users;
+        std::vector<std::string> countries;
+        std::vector<bool> flags;
+        std::vector<int64_t> amounts;
+        for (size_t i = 0; i < rowsPerBatch; ++i) {
+            uint64_t x = Mix(b * rowsPerBatch + i);
+            // more users than the initial table holds, so it grows
+            users.push_back(static_cast<int32_t>(x % 1500) - 700);
+            countries.push_back("country" + std::to_string(x % 13));
+            flags.push_back(x % 3 == 0);
+            amounts.push_back(static_cast<int64_t>(x >> 20) - (1LL << 42));
+        }
+
+        std::vector<Column> columns;
+        columns.push_back(Column::CreateInt32("user", users));
+        columns.push_back(Column::CreateString("country", countries));
+        columns.push_back(Column::CreateBool("flag", flags));
+        columns.push_back(Column::CreateInt64("amount", amounts));
+        for (size_t i = b; i < rowsPerBatch; i += 11) {
+            columns[0].SetNull(i);
+            columns[1].SetNull(i + 3 < rowsPerBatch ? i + 3 : i);
+            columns[3].SetNull(i / 2);
+        }
+        Batch batch(std::move(columns));
+
+        Bitmap mask;
+        for (size_t i = 0; i < rowsPerBatch; ++i) {
+            mask.push_back(Mix(b * rowsPerBatch + i) % 4 != 0);
+        }
+        batch.SetSelectionMask(mask);
+        batches.push_back(std::move(batch));
+    }
+
+    struct Reference {
+        int64_t rows = 0;
+        int64_t count = 0;
+        int64_t sum = 0;
+        int64_t min = std::numeric_limits<int64_t>::max();
+        int64_t max = std::numeric_limits<int64_t>::min();
+    };
+    auto makeKey = [](const Batch& batch, const std::vector<size_t>& keys,
+                      size_t row) {
+        std::string key;
+        for (size_t c : keys) {
+            const Column& column = batch.GetColumn(c);
+            key += column.IsNull(row) ? "<null>" : column.GetValueAsString(row);
+            key += '|';
+        }
+        return key;
+    };
+
+    std::vector<Compute::AggregateSpec> aggregates(6);
+    aggregates[0].function = AggregateFunction::COUNT;
+    aggregates[1].function = AggregateFunction::COUNT;
+    aggregates[1].column = "amount";
+    aggregates[2].function = AggregateFunction::SUM;
+    aggregates[2].column = "amount";
+    aggregates[3].function = AggregateFunction::MIN;
+    aggregates[3].column = "amount";
+    aggregates[4].function = AggregateFunction::MAX;
+    aggregates[4].column = "amount";
+    aggregates[5].function = AggregateFunction::AVG;
+    aggregates[5].column = "amount";
+    aggregates[5].name = "mean";
+
+    auto check = [&](const std::vector<std::string>& keyNames,
+                     const Compute::HashGroupBy& groupBy) {
+        std::vector<size_t> keys;
+        for (const auto& name : keyNames) {
+            keys.push_back(*schema.FindColumn(name));
+        }
+
+        std::map<std::string, Reference> expected;
+        for (const Batch& batch : batches) {
+            for (uint32_t row : *batch.GetSelection()) {
+                Reference& ref = expected[makeKey(batch, keys, row)];
+                ++ref.rows;
+                const Column& amount = batch.GetColumn(3);
+                if (amount.IsNull(row)) {
+                    continue;
+                }
+                int64_t value = amount.GetTypedData<int64_t>()[row];
+                ++ref.count;
+                ref.sum += value;
+                ref.min = std::min(ref.min, value);
+                ref.max = std::max(ref.max, value);
+            }
+        }
+
+        Batch result = groupBy.GetResult();
+        ASSERT_EQ(groupBy.GetGroupCount(), expected.size());
+        ASSERT_EQ(result.GetRowCount(), expected.size());
+        ASSERT_EQ(result.GetColumnCount(), keys.size() + aggregates.size());
+        EXPECT_EQ(result.GetColumn(keys.size()).GetName(), "count(*)");
+        EXPECT_EQ(result.GetColumn(keys.size() + 2).GetName(), "sum(amount)");
+
+        std::vector<size_t> resultKeys(keys.size());
+        std::iota(resultKeys.begin(), resultKeys.end(), 0);
+        std::set<std::string> seen;
+        for (size_t g = 0; g < result.GetRowCount(); ++g) {
+            std::string key = makeKey(result, resultKeys, g);
+            ASSERT_TRUE(seen.insert(key).second) << key;
+            ASSERT_TRUE(expected.contains(key)) << key;
+            const Reference& ref = expected[key];
+
+            auto value = [&](size_t aggregate) {
+                return result.GetColumn(keys.size() + aggregate)
+                    .GetValueAsString(g);
+            };
+            ASSERT_EQ(value(0), std::to_string(ref.rows)) << key;
+            ASSERT_EQ(value(1), std::to_string(ref.count)) << key;
+            if (ref.count == 0) {
+                EXPECT_TRUE(result.GetColumn(keys.size() + 2).IsNull(g));
+                continue;
+            }
+            ASSERT_EQ(value(2), std::to_string(ref.sum)) << key;
+            ASSERT_EQ(value(3), std::to_string(ref.min)) << key;
+            ASSERT_EQ(value(4), std::to_string(ref.max)) << key;
+            EXPECT_DOUBLE_EQ(std::stod(value(5)),
+                             static_cast<double>(ref.sum) /
+                                 static_cast<double>(ref.count));
+        }
+    };
+
+    // single integer key
+    Compute::HashGroupBy byUser(schema, {"user"}, aggregates);
+    for (const Batch& batch : batches) {
+        byUser.Consume(batch);
+    }
+    check({"user"}, byUser);
+
+    // serialized composite keys
+    Compute::HashGroupBy byCountryFlag(schema, {"country", "flag"},
+                                       aggregates);
+    for (const Batch& batch : batches) {
+        byCountryFlag.Consume(batch);
+    }
+    check({"country", "flag"}, byCountryFlag);
+
+    // dictionary codes give the same groups as the strings
+    Compute::HashGroupBy byCountry(schema, {"country"}, aggregates);
+    Compute::HashGroupBy byCode(schema, {"country"}, aggregates);
+    for (const Batch& batch : batches) {
+        const Column& country = batch.GetColumn(1);
+        DictionaryColumn dictionary;
+        dictionary.name = "country";
+        for (size_t i = 0; i < 13; ++i) {
+            dictionary.dictionary.push_back("country" + std::to_string(i));
+        }
+        for (size_t row = 0; row < batch.GetRowCount(); ++row) {
+            std::string value = country.GetValueAsString(row);
+            dictionary.codes.push_back(
+                country.IsNull(row) ? 0 : std::stoul(value.substr(7)));
+        }
+        dictionary.validity = *country.GetValidity();
+
+        byCountry.Consume(batch);
+        byCode.Consume(batch, dictionary);
+    }
+    check({"country"}, byCountry);
+    check({"country"}, byCode);
+
+    std::vector<Compute::AggregateSpec> invalid(1);
+    invalid[0].function = AggregateFunction::SUM;
+    invalid[0].column = "country";
+    EXPECT_THROW(Compute::HashGroupBy(schema, {"user"}, invalid),
+                 std::invalid_argument);
+    EXPECT_THROW(Compute::HashGroupBy(schema, {"missing"}, aggregates),
+                 std::invalid_argument);
+    EXPECT_THROW(byUser.Consume(batches[0], DictionaryColumn{}),
+                 std::invalid_argument);
+}
+
+TEST_F(FixtureE2E, MovedFromStringVectorsStayUsable) {
+    StringVector source{"alpha", "beta", "gamma"};
+    StringVector moved(std::move(source));
+    EXPECT_EQ(moved, StringVector({"alpha", "beta", "gamma"}));
+
+    // moved-from vectors are empty and accept new values
+    EXPECT_EQ(source.size(), 0);
+    EXPECT_TRUE(source.empty());
+    EXPECT_EQ(source.begin(), source.end());
+    source.push_back("delta");
+    ASSERT_EQ(source.size(), 1);
+    EXPECT_EQ(source[0], "delta");
+
+    StringVector target{"x"};
+    target = std::move(source);
+    EXPECT_EQ(target, StringVector({"delta"}));
+    EXPECT_TRUE(source.empty());
+    EXPECT_EQ(source.GetOffsets().size(), 1);
+    source.push_back("epsilon");
+    EXPECT_EQ(source, StringVector({"epsilon"}));
+
+    // columns built from a moved-from vector read back what was appended
+    Column column("name", Types::DataType::STRING, std::move(moved));
+    EXPECT_EQ(column.GetRowCount(), 3);
+    moved.push_back("zeta");
+    Column reused = Column::CreateString("reused", std::move(moved));
+    ASSERT_EQ(reused.GetRowCount(), 1);
+    EXPECT_EQ(reused.GetValueAsString(0), "zeta");
+}
+
+TEST_F(FixtureE2E, CsvReaderKeepsMultilineRecordsWhole) {
+    WriteFile(kTestInputSchemaCsv, "id,int32\ntext,string\n");
+
+    // multiline fields, one with a blank line, around every batch boundary
+    const size_t numRows = 3 * kBatchSize + 100;
+    std::vector<std::string> texts;
+    std::string data;
+    for (size_t i = 0; i < numRows; ++i) {
+        std::string text = "row" + std::to_string(i);
+        if (i % kBatchSize >= kBatchSize - 3 || i % kBatchSize < 2) {
+            text += i % 2 == 0 ? "\nnext line" : "\n\nafter a blank line";
+        }
+        texts.push_back(text);
+        data += std::to_string(i) + ",\"" + text + "\"\n";
+        if (i % 500 == 0) {
+            data += "\n";  // blank lines between records are skipped
+        }
+    }
+    WriteFile(kTestInputDataCsv, data);
+
+    IO::CsvReader reader(kTestInputDataCsv,
+                         Parser::LoadSchemaFromCsv(kTestInputSchemaCsv));
+    size_t row = 0;
+    while (auto batch = reader.ReadBatch()) {
+        EXPECT_LE(batch->GetRowCount(), kBatchSize);
+        for (size_t r = 0; r < batch->GetRowCount(); ++r, ++row) {
+            ASSERT_EQ(batch->GetColumn(0).GetValueAsString(r),
+                      std::to_string(row));
+            ASSERT_EQ(batch->GetColumn(1).GetValueAsString(r), texts[row]);
+        }
+    }
+    EXPECT_EQ(row, numRows);
+    EXPECT_EQ(reader.GetTotalRowsRead(), numRows);
+}
+
+TEST_F(FixtureE2E, WrappingFooterOffsetsAreRejected) {
+    WriteFile(kTestInputDataCsv, "1\n2\n3\n");
+    WriteFile(kTestInputSchemaCsv, "a,int64\n");
+    Schema schema = Parser::LoadSchemaFromCsv(kTestInputSchemaCsv);
+
+    {
+        IO::CsvReader csvReader(kTestInputDataCsv, schema);
+        IO::FormatWriter formatWriter(kTestIyxFile);
+        formatWriter.Begin(schema);
+        while (auto batch = csvReader.ReadBatch()) {
+            formatWriter.WriteRowGroup(RowGroup(std::move(*batch)));
+        }
+        formatWriter.End();
+    }
+
+    std::string file;
+    {
+        std::ifstream input(kTestIyxFile, std::ios::binary);
+        file.assign(std::istreambuf_iterator<char>(input), {});
+    }
+    uint64_t footerOffset;
+    std::memcpy(&footerOffset, file.data() + 24, sizeof(footerOffset));
+
+    // footer: row group offset, size and row count, then chunk offset and
+    // size
+    const size_t groupOffset = footerOffset;
+    const size_t groupSize = footerOffset + 8;
+    const size_t chunkOffset = footerOffset + 20;
+    const size_t chunkSize = footerOffset + 28;
+    const uint64_t kWrapping = std::numeric_limits<uint64_t>::max() - 7;
+
+    using TPatches = std::vector<std::pair<size_t, uint64_t>>;
+    for (const TPatches& patches :
+         {TPatches{{groupOffset, kWrapping},
+                   {groupSize, 16},
+                   {chunkOffset, kWrapping},
+                   {chunkSize, 16}},
+          TPatches{{chunkSize, kWrapping}}}) {
+        std::string corrupt = file;
+        for (auto [pos, value] : patches) {
+            std::memcpy(corrupt.data() + pos, &value, sizeof(value));
+        }
+        WriteFile(kTestIyxFile, corrupt);
+
+        for (bool useMmap : {false, true}) {
+            IO::FormatReaderOptions options;
+            options.useMmap = useMmap;
+            IO::FormatReader reader(kTestIyxFile, options);
+            EXPECT_THROW(reader.Open(), std::runtime_error);
+        }
+    }
+}
+
 }  // namespace Columnar::Test
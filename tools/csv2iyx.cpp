@@ -1,9 +1,10 @@
-#include <io/csv_reader.h>
+#include <io/parallel_csv_reader.h>
 #include <io/format_writer.h>
 #include <parser/schema_parser.h>
 
 #include <exception>
 #include <iostream>
+#include <thread>
 
 int main(int argc, char* argv[]) {
     if (argc != 4) {
@@ -15,17 +16,19 @@ int main(int argc, char* argv[]) {
         Columnar::Schema schema = Columnar::Parser::LoadSchemaFromCsv(argv[1]);
         std::cerr << "Schema: " << schema.GetColumnCount() << " columns\n";
 
-        Columnar::IO::CsvReader reader(argv[2], schema);
-        Columnar::IO::FormatWriter writer(argv[3]);
+        Columnar::IO::ParallelCsvReader reader(argv[2], schema);
+        // row groups are encoded on all cores while parsing continues here
+        Columnar::IO::FormatWriterOptions writerOptions;
+        writerOptions.encodeThreads = std::thread::hardware_concurrency();
+        Columnar::IO::FormatWriter writer(argv[3], writerOptions);
 
         writer.Begin(schema);
 
         size_t batchNum = 0;
         while (auto batch = reader.ReadBatch()) {
-            Columnar::RowGroup rg(std::move(*batch));
-            writer.WriteRowGroup(rg);
-            std::cerr << "Batch " << ++batchNum << ": "
-                      << rg.GetBatch().GetRowCount() << " rows\n";
+            std::cerr << "Batch " << ++batchNum << ": " << batch->GetRowCount()
+                      << " rows\n";
+            writer.WriteRowGroup(Columnar::RowGroup(std::move(*batch)));
         }
 
         writer.End();
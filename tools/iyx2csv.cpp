@@ -1,16 +1,48 @@
-#include <io/csv_writer.h>
+#include <io/csv_export.h>
 #include <io/format_reader.h>
 #include <parser/schema_parser.h>
 
+#include <filesystem>
 #include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// data.csv -> data.0.csv, data.1.csv, ... when splitting into several files
+std::vector<std::string> GetOutputFilenames(const std::string& filename,
+                                            size_t fileCount) {
+    if (fileCount == 1) {
+        return {filename};
+    }
+
+    std::filesystem::path path(filename);
+    std::vector<std::string> filenames;
+    for (size_t i = 0; i < fileCount; ++i) {
+        std::filesystem::path part = path;
+        part.replace_extension(std::to_string(i) +
+                               path.extension().string());
+        filenames.push_back(part.string());
+    }
+    return filenames;
+}
+
+}  // namespace
 
 int main(int argc, char* argv[]) {
-    if (argc != 4) {
-        std::cerr << "Usage: iyx2csv <input.iyx> <data.csv> <schema.csv>\n";
+    if (argc != 4 && argc != 5) {
+        std::cerr << "Usage: iyx2csv <input.iyx> <data.csv> <schema.csv> "
+                     "[file count]\n";
         return 1;
     }
 
     try {
+        size_t fileCount = argc == 5 ? std::stoul(argv[4]) : 1;
+        if (fileCount == 0) {
+            std::cerr << "File count must be positive\n";
+            return 1;
+        }
+
         Columnar::IO::FormatReader reader(argv[1]);
         reader.Open();
 
@@ -22,17 +54,15 @@ int main(int argc, char* argv[]) {
         Columnar::Parser::SaveSchemaToCsv(reader.GetSchema(), argv[3]);
         std::cerr << "Schema saved to: " << argv[3] << "\n";
 
-        Columnar::IO::CsvWriter writer(argv[2]);
-
-        for (size_t i = 0; i < reader.GetRowGroupCount(); ++i) {
-            Columnar::RowGroup rg = reader.ReadRowGroup(i);
-            writer.WriteBatch(rg.GetBatch());
-            std::cerr << "RowGroup " << i << ": " << rg.GetBatch().GetRowCount()
-                      << " rows\n";
-        }
+        // row groups are decoded and formatted on all cores, written in order
+        Columnar::IO::CsvExportOptions options;
+        options.onRowGroupWritten = [](size_t index, size_t rowCount) {
+            std::cerr << "RowGroup " << index << ": " << rowCount << " rows\n";
+        };
 
-        writer.Flush();
-        std::cerr << "Done! Written: " << writer.GetRowsWritten() << " rows\n";
+        size_t rowsWritten = Columnar::IO::ExportCsv(
+            reader, GetOutputFilenames(argv[2], fileCount), options);
+        std::cerr << "Done! Written: " << rowsWritten << " rows\n";
 
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << "\n";
@@ -40,4 +70,4 @@ int main(int argc, char* argv[]) {
     }
 
     return 0;
-}
\ No newline at end of file
+}